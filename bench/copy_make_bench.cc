@@ -0,0 +1,185 @@
+/**
+ *  \file   copy_make_bench.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "argparse/argparse.hpp"
+
+#include "chess/chess.h"
+#include "chess/movegen.h"
+#include "chess/position.h"
+#include "chess/util.h"
+
+namespace {
+/**
+ * Positions to search from
+ */
+constexpr const char* kFens[] = {
+    chess::Position::kDefaultFen,
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"
+};
+
+/**
+ * @brief Count the nodes of a tree by making and unmaking each move
+ *
+ * @param pos   The position to search from, restored on return
+ * @param depth The remaining depth
+ *
+ * @return The number of nodes visited, not counting \a pos
+ */
+template <chess::Player P>
+std::uint64_t MakeUnmake(chess::Position* pos, std::uint32_t depth) {
+    if (depth == 0u) return 0;
+
+    std::array<std::uint32_t, chess::kMaxMoves> moves;
+
+    const std::size_t n_moves = pos->InCheck<P>() ?
+        chess::GenerateCheckEvasions<P>(*pos, moves.data()) :
+        chess::GenerateLegalMoves<P>(*pos, moves.data());
+
+    std::uint64_t nodes = n_moves;
+
+    for (std::size_t i = 0; i < n_moves; i++) {
+        chess::Position::UndoInfo undo;
+        pos->MakeMove<P>(moves[i], &undo);
+
+        nodes += MakeUnmake<chess::util::opponent<P>()>(pos, depth-1);
+
+        pos->UnMakeMove<P>(moves[i], undo);
+    }
+
+    return nodes;
+}
+
+/**
+ * @brief Count the nodes of a tree by making each move in a copy of the
+ *        position
+ *
+ * @param pos   The position to search from
+ * @param depth The remaining depth
+ *
+ * @return The number of nodes visited, not counting \a pos
+ */
+template <chess::Player P>
+std::uint64_t CopyMake(const chess::Position& pos, std::uint32_t depth) {
+    if (depth == 0u) return 0;
+
+    std::array<std::uint32_t, chess::kMaxMoves> moves;
+
+    const std::size_t n_moves = pos.InCheck<P>() ?
+        chess::GenerateCheckEvasions<P>(pos, moves.data()) :
+        chess::GenerateLegalMoves<P>(pos, moves.data());
+
+    std::uint64_t nodes = n_moves;
+
+    chess::Position child;
+
+    for (std::size_t i = 0; i < n_moves; i++) {
+        child.CopyMake<P>(pos, moves[i]);
+
+        nodes += CopyMake<chess::util::opponent<P>()>(child, depth-1);
+    }
+
+    return nodes;
+}
+
+/**
+ * @brief Time one of the traversals over all test positions
+ *
+ * @param name     The name of the traversal, for display
+ * @param depth    The depth to search each position to
+ * @param traverse Returns the nodes below a position of a given depth
+ */
+template <typename Traverse>
+void Time(const char* name, std::uint32_t depth, Traverse&& traverse) {
+    std::uint64_t nodes = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const char* fen : kFens) {
+        chess::Position pos;
+        if (pos.Reset(fen) != chess::Position::FenError::kSuccess) {
+            throw std::runtime_error("Invalid FEN: " + std::string(fen));
+        }
+
+        nodes += traverse(&pos, depth);
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(stop - start).count();
+
+    std::printf("%-12s %12llu %10.3f %12.2f\n", name,
+                static_cast<unsigned long long>(nodes), seconds,
+                nodes / seconds / 1e6);
+}
+
+/**
+ * @brief Parse command line and run this program
+ *
+ * @return True on success
+ */
+bool go(const argparse::ArgumentParser& parser) {
+    const auto depth = parser.get<std::uint32_t>("--depth");
+
+    std::printf("sizeof(Position) = %zu, sizeof(UndoInfo) = %zu\n\n",
+                sizeof(chess::Position), sizeof(chess::Position::UndoInfo));
+
+    std::printf("%-12s %12s %10s %12s\n", "mode", "nodes", "seconds",
+                "Mnodes/sec");
+
+    Time("make/unmake", depth, [](chess::Position* pos, std::uint32_t d) {
+        return pos->ToMove() == chess::Player::kWhite ?
+            MakeUnmake<chess::Player::kWhite>(pos, d) :
+            MakeUnmake<chess::Player::kBlack>(pos, d);
+    });
+
+    Time("copy-make", depth, [](chess::Position* pos, std::uint32_t d) {
+        return pos->ToMove() == chess::Player::kWhite ?
+            CopyMake<chess::Player::kWhite>(*pos, d) :
+            CopyMake<chess::Player::kBlack>(*pos, d);
+    });
+
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    argparse::ArgumentParser parser("copy-make-bench");
+
+    parser.add_argument("--depth")
+        .help("Depth to search each test position to")
+        .default_value(std::uint32_t(4))
+        .scan<'u', std::uint32_t>();
+
+    try {
+        parser.parse_args(argc, argv);
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        std::cerr << parser;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        return go(parser) ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
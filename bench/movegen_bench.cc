@@ -0,0 +1,263 @@
+/**
+ *  \file   movegen_bench.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+
+#include "chess/chess.h"
+#include "chess/data_tables.h"
+#include "chess/movegen.h"
+#include "chess/position.h"
+#include "chess/util.h"
+
+namespace {
+/**
+ * Positions to generate moves for
+ */
+constexpr const char* kFens[] = {
+    chess::Position::kDefaultFen,
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"
+};
+
+/**
+ * @brief The 16-bit lookup table LSB which util::Lsb() replaced, kept for
+ *        comparison
+ */
+std::int8_t TableLsb(std::uint64_t qword) noexcept {
+    const auto& lsb = chess::data_tables::kLsb;
+
+    qword &= (-qword);
+
+    if (qword < 0x0000000010000ull) return 00 + lsb[qword >> 00];
+    if (qword < 0x0000100000000ull) return 16 + lsb[qword >> 16];
+    if (qword < 0x1000000000000ull) return 32 + lsb[qword >> 32];
+
+    return 48 + lsb[qword >> 48];
+}
+
+/**
+ * @brief The 16-bit lookup table MSB which util::Msb() replaced, kept for
+ *        comparison
+ */
+std::int8_t TableMsb(std::uint64_t qword) noexcept {
+    const auto& msb = chess::data_tables::kMsb;
+
+    if (qword < 0x0000000010000ull) return 00 + msb[qword >> 00];
+    if (qword < 0x0000100000000ull) return 16 + msb[qword >> 16];
+    if (qword < 0x1000000000000ull) return 32 + msb[qword >> 32];
+
+    return 48 + msb[qword >> 48];
+}
+
+/**
+ * @brief The 16-bit lookup table bit count which util::BitCount() replaced,
+ *        kept for comparison
+ */
+std::int8_t TableBitCount(std::uint64_t qword) noexcept {
+    return chess::data_tables::kPop[qword >> 00 & 0xffff] +
+           chess::data_tables::kPop[qword >> 16 & 0xffff] +
+           chess::data_tables::kPop[qword >> 32 & 0xffff] +
+           chess::data_tables::kPop[qword >> 48];
+}
+
+/**
+ * @brief Time a bit scan by serializing a set of words, the way move
+ *        generation does
+ *
+ * @param words  The words to serialize
+ * @param passes The number of times to visit \a words
+ * @param scan   The bit scan to time
+ *
+ * @return Nanoseconds per call
+ */
+template <typename Scan>
+double TimeScan(const std::vector<std::uint64_t>& words,
+                std::size_t passes,
+                Scan scan) {
+    std::uint64_t sum = 0, calls = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t pass = 0; pass < passes; pass++) {
+        for (std::uint64_t word : words) {
+            while (word) {
+                const std::int8_t bit = scan(word);
+                word &= ~(std::uint64_t(1) << bit);
+                sum += bit;
+                calls++;
+            }
+        }
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    // Keep the loop from being optimized away
+
+    if (sum == 0u) std::printf(" ");
+
+    return std::chrono::duration<double, std::nano>(stop - start).count() /
+        calls;
+}
+
+/**
+ * @brief Time a bit count over a set of words
+ *
+ * @param words  The words to count the bits of
+ * @param passes The number of times to visit \a words
+ * @param count  The bit count to time
+ *
+ * @return Nanoseconds per call
+ */
+template <typename Count>
+double TimeCount(const std::vector<std::uint64_t>& words,
+                 std::size_t passes,
+                 Count count) {
+    std::uint64_t sum = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t pass = 0; pass < passes; pass++) {
+        for (std::uint64_t word : words) sum += count(word);
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    if (sum == 0u) std::printf(" ");
+
+    return std::chrono::duration<double, std::nano>(stop - start).count() /
+        (passes * words.size());
+}
+
+/**
+ * @brief Generate moves for a position many times over
+ *
+ * @param pos    The position to generate moves for
+ * @param passes The number of times to generate moves
+ *
+ * @return The total number of moves generated
+ */
+template <chess::Player P>
+std::uint64_t GenerateMoves(const chess::Position& pos, std::size_t passes) {
+    std::array<std::uint32_t, chess::kMaxMoves> moves;
+    std::uint64_t total = 0;
+
+    for (std::size_t pass = 0; pass < passes; pass++) {
+        total += pos.InCheck<P>() ?
+            chess::GenerateCheckEvasions<P>(pos, moves.data()) :
+            chess::GenerateLegalMoves<P>(pos, moves.data());
+    }
+
+    return total;
+}
+
+/**
+ * @brief Parse command line and run this program
+ *
+ * @return True on success
+ */
+bool go(const argparse::ArgumentParser& parser) {
+    const auto passes = parser.get<std::size_t>("--passes");
+
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+    // The tables were already built at startup; this times a rebuild
+
+    const auto init_start = std::chrono::steady_clock::now();
+    chess::data_tables::internal::InitTableArena();
+    const auto init_stop = std::chrono::steady_clock::now();
+
+    std::printf("tables: built in %.1f us\n\n",
+                std::chrono::duration<double, std::micro>(
+                    init_stop - init_start).count());
+#endif
+
+    // Bit scans, over words with a typical attack set density
+
+    std::mt19937_64 rng(2026);
+
+    std::vector<std::uint64_t> words(4096);
+    for (auto& word : words) word = rng() & rng() & rng();
+
+    std::printf("%-10s %12s %12s\n", "primitive", "table (ns)", "util (ns)");
+
+    std::printf("%-10s %12.3f %12.3f\n", "Lsb",
+                TimeScan(words, passes, TableLsb),
+                TimeScan(words, passes, chess::util::Lsb));
+    std::printf("%-10s %12.3f %12.3f\n", "Msb",
+                TimeScan(words, passes, TableMsb),
+                TimeScan(words, passes, chess::util::Msb));
+    std::printf("%-10s %12.3f %12.3f\n", "BitCount",
+                TimeCount(words, passes, TableBitCount),
+                TimeCount(words, passes, chess::util::BitCount));
+
+    // Move generation, which calls chess::util::Msb() once per piece and
+    // once per move
+
+    std::uint64_t total = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const char* fen : kFens) {
+        chess::Position pos;
+        if (pos.Reset(fen) != chess::Position::FenError::kSuccess) {
+            throw std::runtime_error("Invalid FEN: " + std::string(fen));
+        }
+
+        total += pos.ToMove() == chess::Player::kWhite ?
+            GenerateMoves<chess::Player::kWhite>(pos, passes * 64) :
+            GenerateMoves<chess::Player::kBlack>(pos, passes * 64);
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(stop - start).count();
+
+    std::printf("\nmovegen: %llu moves in %.3f s (%.1f Mmoves/sec)\n",
+                static_cast<unsigned long long>(total), seconds,
+                total / seconds / 1e6);
+
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    argparse::ArgumentParser parser("movegen-bench");
+
+    parser.add_argument("--passes")
+        .help("Number of passes over the test data")
+        .default_value(std::size_t(2000))
+        .scan<'u', std::size_t>();
+
+    try {
+        parser.parse_args(argc, argv);
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        std::cerr << parser;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        return go(parser) ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,127 @@
+/**
+ *  \file   mtcs_bench.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "argparse/argparse.hpp"
+
+#include "chess/logger.h"
+#include "chess/memory_pool.h"
+#include "chess/mtcs.h"
+#include "chess/null_stream_channel.h"
+#include "chess/position.h"
+
+/**
+ * @brief Time a single search
+ *
+ * @param fen        The root position
+ * @param iterations The number of playouts to run
+ * @param threads    The number of search threads
+ * @param pool_size  The size of the node pool, in bytes
+ *
+ * @return The number of playouts per second
+ */
+double RunSearch(const std::string& fen,
+                 std::size_t iterations,
+                 std::size_t threads,
+                 std::size_t pool_size) {
+    chess::Position position;
+    if (position.Reset(fen) != chess::Position::FenError::kSuccess) {
+        throw std::runtime_error("Invalid FEN: " + fen);
+    }
+
+    auto logger = std::make_shared<chess::Logger>(
+        "bench", std::make_shared<chess::NullOstreamChannel>());
+
+    auto pool = std::make_shared<chess::MemoryPool<chess::Mtcs::Node>>(
+        pool_size, logger);
+
+    chess::Mtcs mtcs(pool, logger);
+    mtcs.SetIterations(iterations);
+    mtcs.SetThreads(threads);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    mtcs.Run(position);
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(stop - start).count();
+
+    return mtcs.Iterations() / seconds;
+}
+
+/**
+ * @brief Parse command line and run this program
+ *
+ * @return True on success
+ */
+bool go(const argparse::ArgumentParser& parser) {
+    const auto fen = parser.get<std::string>("--fen");
+    const auto iterations = parser.get<std::size_t>("--iterations");
+    const auto max_threads = parser.get<std::size_t>("--threads");
+    const auto pool_mb = parser.get<std::size_t>("--pool");
+
+    std::printf("%8s %16s %8s\n", "threads", "playouts/sec", "speedup");
+
+    double baseline = 0.0;
+
+    for (std::size_t threads = 1; threads <= max_threads; threads++) {
+        const double rate =
+            RunSearch(fen, iterations, threads, pool_mb * 1024 * 1024);
+
+        if (threads == 1) baseline = rate;
+
+        std::printf("%8zu %16.0f %8.2f\n", threads, rate, rate / baseline);
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    argparse::ArgumentParser parser("mtcs-bench");
+
+    parser.add_argument("--fen")
+        .help("The position to search")
+        .default_value(std::string(chess::Position::kDefaultFen));
+    parser.add_argument("--iterations")
+        .help("Number of playouts per search")
+        .default_value(std::size_t(20000))
+        .scan<'u', std::size_t>();
+    parser.add_argument("--threads")
+        .help("Benchmark from 1 up to this many threads")
+        .default_value(std::max<std::size_t>(
+            std::thread::hardware_concurrency(), 1))
+        .scan<'u', std::size_t>();
+    parser.add_argument("--pool")
+        .help("Size of the node pool, in megabytes")
+        .default_value(std::size_t(512))
+        .scan<'u', std::size_t>();
+
+    try {
+        parser.parse_args(argc, argv);
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        std::cerr << parser;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        return go(parser) ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
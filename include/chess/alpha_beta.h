@@ -0,0 +1,557 @@
+/**
+ *  \file   alpha_beta.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#ifndef CHESS_ALPHA_BETA_H_
+#define CHESS_ALPHA_BETA_H_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "chess/chess.h"
+#include "chess/evaluate.h"
+#include "chess/game_history.h"
+#include "chess/logger.h"
+#include "chess/move_picker.h"
+#include "chess/movegen.h"
+#include "chess/position.h"
+#include "chess/search.h"
+#include "chess/transposition_table.h"
+#include "chess/util.h"
+
+namespace chess {
+/**
+ * @brief Iterative deepening principal variation search (PVS)
+ *
+ * Each iteration is searched with an aspiration window centered on the score
+ * of the previous iteration. Leaf nodes are resolved by a quiescence search
+ * over captures, promotions and check evasions
+ */
+class AlphaBeta final : public Search {
+public:
+    /**
+     * The maximum depth (in plies) the search will reach, including
+     * quiescence and check extensions
+     */
+    static constexpr int kMaxSearchPly = 128;
+
+    static_assert(kMaxSearchPly < kMaxPly);
+
+    /**
+     * The score of delivering checkmate at the root. Mate at ply N is scored
+     * as kMateScore - N
+     */
+    static constexpr int kMateScore = 30000;
+
+    AlphaBeta(std::shared_ptr<TranspositionTable> table,
+              std::shared_ptr<Logger> logger);
+
+    AlphaBeta(const AlphaBeta& algorithm) = delete;
+    AlphaBeta(AlphaBeta&& algorithm) = delete;
+    AlphaBeta& operator=(const AlphaBeta& algorithm) = delete;
+    AlphaBeta& operator=(AlphaBeta&& algorithm) = delete;
+
+    ~AlphaBeta() = default;
+
+    int Depth() const noexcept;
+
+    std::uint64_t Nodes() const noexcept;
+
+    std::vector<std::uint32_t> PrincipalVariation() const;
+
+    std::uint32_t Run(const Position& position) override;
+
+    int Score() const noexcept;
+
+    void SetMaxDepth(int depth) noexcept;
+
+    void SetMaxNodes(std::uint64_t nodes) noexcept;
+
+private:
+    /**
+     * Bound on all scores, larger than any mate score
+     */
+    static constexpr int kInfinity = 32000;
+
+    /**
+     * Half-width of the initial aspiration window
+     */
+    static constexpr int kAspirationWindow = 25;
+
+    /**
+     * The clock is read once per this many nodes. Must be a power of two
+     */
+    static constexpr std::uint64_t kTimeCheckInterval = 1024;
+
+    /**
+     * History scores are halved once one reaches this value, which keeps
+     * them below the killer move scores
+     */
+    static constexpr std::int32_t kHistoryMax = 1 << 20;
+
+    static_assert(kHistoryMax < MovePicker<Player::kWhite>::kKillerScore);
+
+    static int FromTable(int score, int ply) noexcept;
+
+    template <Player P>
+    std::uint32_t Iterate(Position* position);
+
+    template <Player P>
+    int Quiesce(Position* position, int ply, int alpha, int beta,
+                bool checks);
+
+    template <Player P>
+    int SearchNode(Position* position, int depth, int ply, int alpha,
+                   int beta);
+
+    bool StopRequested() noexcept;
+
+    static int ToTable(int score, int ply) noexcept;
+
+    template <Player P>
+    void UpdateHistory(std::uint32_t move, int depth, int ply) noexcept;
+
+    void UpdatePv(int ply, std::uint32_t move) noexcept;
+
+    /**
+     * Set when a search limit is reached or the search was stopped, and the
+     * search must unwind
+     */
+    bool aborted_;
+
+    /**
+     * History heuristic scores for quiet moves, indexed by player, origin
+     * and destination
+     */
+    std::vector<std::array<std::array<std::int32_t, 64>, 64>> history_;
+
+    /**
+     * Two quiet moves per ply which most recently caused a beta cutoff
+     */
+    std::vector<std::array<std::uint32_t, 2>> killers_;
+
+    /**
+     * For logging search progress
+     */
+    std::shared_ptr<Logger> logger_;
+
+    /**
+     * Search no deeper than this many plies (excluding extensions)
+     */
+    int max_depth_;
+
+    /**
+     * Abort the search after visiting this many nodes
+     */
+    std::uint64_t max_nodes_;
+
+    /**
+     * Number of nodes visited by the current search
+     */
+    std::uint64_t nodes_;
+
+    /**
+     * The positions leading to the current node, starting with those played
+     * before the root
+     */
+    GameHistory path_;
+
+    /**
+     * Triangular table of principal variations. Row N holds the best line
+     * found starting from ply N
+     */
+    std::vector<std::array<std::uint32_t, kMaxSearchPly>> pv_;
+
+    /**
+     * The length of each row of \ref pv_
+     */
+    std::array<int, kMaxSearchPly> pv_length_;
+
+    /**
+     * The principal variation from the last completed iteration
+     */
+    std::vector<std::uint32_t> root_pv_;
+
+    /**
+     * The depth of the last completed iteration
+     */
+    int root_depth_;
+
+    /**
+     * The score of the last completed iteration
+     */
+    int root_score_;
+
+    /**
+     * The maximum distance from the root reached by the current search
+     */
+    int seldepth_;
+
+    /**
+     * Table of results shared with other searches
+     */
+    std::shared_ptr<TranspositionTable> table_;
+};
+
+/**
+ * @brief Run iterative deepening from the root position
+ *
+ * @tparam P The player whose turn it is
+ *
+ * @param position The root position
+ *
+ * @return The best move found
+ */
+template <Player P>
+std::uint32_t AlphaBeta::Iterate(Position* position) {
+    std::array<std::uint32_t, kMaxMoves> moves;
+
+    const std::size_t n_moves = position->InCheck<P>() ?
+            GenerateCheckEvasions<P>(*position, moves.data()) :
+            GenerateLegalMoves<P>(*position, moves.data());
+
+    if (n_moves == 0u) return kNullMove;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // Fall back to any legal move if the first iteration doesn't complete
+
+    std::uint32_t best_move = moves[0];
+
+    for (int depth = 1; depth <= max_depth_; depth++) {
+        int delta = kAspirationWindow;
+
+        int alpha = -kInfinity;
+        int beta  =  kInfinity;
+
+        if (depth > 1 && std::abs(root_score_) < kMateScore - kMaxSearchPly) {
+            alpha = root_score_ - delta;
+            beta  = root_score_ + delta;
+        }
+
+        int score = 0;
+
+        while (true) {
+            score = SearchNode<P>(position, depth, 0, alpha, beta);
+
+            if (aborted_) break;
+
+            if (score <= alpha) {
+                alpha = std::max(-kInfinity, score - delta);
+            } else if (score >= beta) {
+                beta  = std::min( kInfinity, score + delta);
+            } else {
+                break;
+            }
+
+            delta *= 2;
+        }
+
+        if (aborted_) break;
+
+        root_depth_ = depth;
+        root_score_ = score;
+        root_pv_.assign(pv_[0].begin(), pv_[0].begin() + pv_length_[0]);
+
+        if (!root_pv_.empty()) best_move = root_pv_[0];
+
+        logger_->Write("depth %d score %d nodes %llu bestmove %s\n",
+                       depth, score,
+                       static_cast<unsigned long long>(nodes_),
+                       util::ToLongAlgebraic(best_move).c_str());
+
+        SearchInfo info;
+        info.depth    = depth;
+        info.hashfull = table_->HashFull();
+        info.nodes    = nodes_;
+        info.pv       = root_pv_;
+        info.seldepth = seldepth_;
+        info.time     = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+        if (std::abs(score) >= kMateScore - kMaxSearchPly) {
+            const int plies = kMateScore - std::abs(score);
+
+            info.mate  = true;
+            info.score = (score > 0 ? 1 : -1) * ((plies + 1) / 2);
+        } else {
+            info.score = score;
+        }
+
+        SendInfo(info);
+
+        // No need to search deeper once a forced mate is found
+
+        if (std::abs(score) >= kMateScore - depth) break;
+
+        // The next iteration would likely not finish in time
+
+        if (SoftLimitReached()) break;
+    }
+
+    return best_move;
+}
+
+/**
+ * @brief Quiescence search. Only captures, promotions and check evasions
+ *        are searched, until the position is quiet. On the first ply, quiet
+ *        checks are searched as well
+ *
+ * @tparam P The player whose turn it is
+ *
+ * @param position The current position
+ * @param ply      Distance from the root
+ * @param alpha    Lower bound of the search window
+ * @param beta     Upper bound of the search window
+ * @param checks   If true, also search quiet moves which give check
+ *
+ * @return The score of \a position from the perspective of \a P
+ */
+template <Player P>
+int AlphaBeta::Quiesce(Position* position, int ply, int alpha, int beta,
+                       bool checks) {
+    constexpr Player O = util::opponent<P>();
+
+    pv_length_[ply] = ply;
+    seldepth_ = std::max(seldepth_, ply);
+
+    if (StopRequested()) return 0;
+
+    if (path_.IsDraw(*position, ply)) return 0;
+
+    if (ply >= kMaxSearchPly - 1) return Evaluate<P>(*position);
+
+    const bool in_check = position->InCheck<P>();
+
+    int best_score = -kInfinity;
+
+    if (!in_check) {
+        // Stand pat: the side to move can usually do at least as well as
+        // the static evaluation by playing a quiet move
+
+        best_score = Evaluate<P>(*position);
+
+        if (best_score >= beta) return best_score;
+
+        alpha = std::max(alpha, best_score);
+    }
+
+    // Captures that lose material once the opponent recaptures are never
+    // returned by the picker
+
+    MovePicker<P> picker(position, history_[util::index<P>()], checks);
+
+    std::size_t n_searched = 0;
+
+    for (std::uint32_t move = picker.Next(); move != kNullMove;
+         move = picker.Next()) {
+        n_searched++;
+
+        path_.Push(position->Hash());
+
+        Position::UndoInfo undo;
+        position->MakeMove<P>(move, &undo);
+
+        const int score = -Quiesce<O>(position, ply+1, -beta, -alpha, false);
+
+        position->UnMakeMove<P>(move, undo);
+
+        path_.Pop();
+
+        if (aborted_) return 0;
+
+        if (score > best_score) {
+            best_score = score;
+
+            if (score > alpha) {
+                alpha = score;
+
+                if (score >= beta) break;
+            }
+        }
+    }
+
+    if (in_check && n_searched == 0u) return -kMateScore + ply;
+
+    return best_score;
+}
+
+/**
+ * @brief Principal variation search
+ *
+ * @tparam P The player whose turn it is
+ *
+ * @param position The current position
+ * @param depth    The remaining search depth
+ * @param ply      Distance from the root
+ * @param alpha    Lower bound of the search window
+ * @param beta     Upper bound of the search window
+ *
+ * @return The score of \a position from the perspective of \a P
+ */
+template <Player P>
+int AlphaBeta::SearchNode(Position* position, int depth, int ply, int alpha,
+                          int beta) {
+    constexpr Player O = util::opponent<P>();
+
+    if (depth <= 0) return Quiesce<P>(position, ply, alpha, beta, true);
+
+    pv_length_[ply] = ply;
+    seldepth_ = std::max(seldepth_, ply);
+
+    if (StopRequested()) return 0;
+
+    // The root is never scored as a draw, so that a move is always found
+
+    if (ply > 0 && path_.IsDraw(*position, ply)) return 0;
+
+    if (ply >= kMaxSearchPly - 1) return Evaluate<P>(*position);
+
+    const bool pv_node = beta - alpha > 1;
+
+    const std::uint64_t hash = position->Hash();
+
+    TranspositionTable::Entry entry;
+    std::uint32_t hash_move = kNullMove;
+
+    if (table_->Probe(hash, &entry)) {
+        hash_move = entry.move;
+
+        // Only take cutoffs outside the principal variation, which keeps
+        // the PV intact
+
+        if (!pv_node && entry.depth >= depth) {
+            const int score = FromTable(entry.score, ply);
+
+            if (entry.bound == Bound::kExact ||
+                (entry.bound == Bound::kLower && score >= beta) ||
+                (entry.bound == Bound::kUpper && score <= alpha)) {
+                return score;
+            }
+        }
+    }
+
+    const bool in_check = position->InCheck<P>();
+
+    // Extend checks so that forcing sequences are not cut short
+
+    if (in_check) depth++;
+
+    MovePicker<P> picker(position, hash_move, killers_[ply],
+                         history_[util::index<P>()]);
+
+    int best_score = -kInfinity;
+    std::uint32_t best_move = kNullMove;
+    Bound bound = Bound::kUpper;
+
+    std::size_t n_searched = 0;
+
+    for (std::uint32_t move = picker.Next(); move != kNullMove;
+         move = picker.Next()) {
+        path_.Push(position->Hash());
+
+        Position::UndoInfo undo;
+        position->MakeMove<P>(move, &undo);
+
+        int score;
+
+        if (n_searched++ == 0u) {
+            score = -SearchNode<O>(position, depth-1, ply+1, -beta, -alpha);
+        } else {
+            // Prove this move is no better than the PV using a null window,
+            // and re-search with the full window only if that fails
+
+            score = -SearchNode<O>(position, depth-1, ply+1,
+                                   -alpha-1, -alpha);
+
+            if (score > alpha && score < beta) {
+                score = -SearchNode<O>(position, depth-1, ply+1,
+                                       -beta, -alpha);
+            }
+        }
+
+        position->UnMakeMove<P>(move, undo);
+
+        path_.Pop();
+
+        if (aborted_) return 0;
+
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+
+            if (score > alpha) {
+                alpha = score;
+                bound = Bound::kExact;
+
+                UpdatePv(ply, move);
+
+                if (score >= beta) {
+                    bound = Bound::kLower;
+
+                    if (util::ExtractCaptured(move) == Piece::EMPTY &&
+                        util::ExtractPromoted(move) == Piece::EMPTY) {
+                        UpdateHistory<P>(move, depth, ply);
+                    }
+
+                    break;
+                }
+            }
+        }
+    }
+
+    if (n_searched == 0u) {
+        return in_check ? -kMateScore + ply : 0;
+    }
+
+    table_->Store(hash, best_move, ToTable(best_score, ply), depth, bound);
+
+    return best_score;
+}
+
+/**
+ * @brief Record a quiet move that caused a beta cutoff
+ *
+ * @tparam P The player who made the move
+ *
+ * @param move  The move that caused the cutoff
+ * @param depth The remaining depth at which the cutoff occurred
+ * @param ply   Distance from the root
+ */
+template <Player P>
+void AlphaBeta::UpdateHistory(std::uint32_t move, int depth,
+                              int ply) noexcept {
+    if (killers_[ply][0] != move) {
+        killers_[ply][1] = killers_[ply][0];
+        killers_[ply][0] = move;
+    }
+
+    auto& history = history_[util::index<P>()];
+
+    std::int32_t& entry =
+        history[util::ExtractFrom(move)][util::ExtractTo(move)];
+
+    entry += depth * depth;
+
+    // Age all entries to keep them below kHistoryMax
+
+    if (entry >= kHistoryMax) {
+        for (auto& from : history) {
+            for (auto& value : from) value /= 2;
+        }
+    }
+}
+
+}  // namespace chess
+
+#endif  // CHESS_ALPHA_BETA_H_
@@ -7,10 +7,98 @@
 #ifndef CHESS_ATTACKS_H_
 #define CHESS_ATTACKS_H_
 
+#include <array>
+#include <cstdint>
+
 #include "chess/chess.h"
 #include "chess/data_tables.h"
 
+/**
+ * How sliding piece attacks are looked up. Auto uses PEXT if the CPU
+ * supports BMI2, which is checked once at startup, and magic multiplication
+ * otherwise. The other two modes use one method only; PEXT requires building
+ * with -mbmi2
+ */
+#define CHESS_ATTACKS_AUTO  0
+#define CHESS_ATTACKS_MAGIC 1
+#define CHESS_ATTACKS_PEXT  2
+
+#ifndef CHESS_SLIDING_ATTACKS
+#define CHESS_SLIDING_ATTACKS CHESS_ATTACKS_AUTO
+#endif
+
+#if CHESS_SLIDING_ATTACKS==CHESS_ATTACKS_PEXT
+#include <immintrin.h>
+#endif
+
 namespace chess {
+namespace detail {
+/**
+ * "Attacks from" databases indexed by PEXT instead of magic multiplication.
+ * They share the per-square offsets of the magic databases
+ */
+struct PextAttacks {
+    /** Bishop attacks */
+    std::array<std::uint64_t, data_tables::kBishopAttacks.size()> bishop;
+
+    /** Rook attacks */
+    std::array<std::uint64_t, data_tables::kRookAttacks.size()> rook;
+};
+
+/**
+ * Filled in at startup, if PEXT is to be used
+ */
+extern PextAttacks pext_attacks;
+
+/**
+ * True if the PEXT databases are ready and the CPU supports BMI2. False
+ * until static initialization has run, so early lookups use magics
+ */
+extern bool use_pext;
+
+/**
+ * @brief Extract the bits of a value selected by a mask into the low bits
+ *        of the result, in order. Needs BMI2
+ *
+ * @param[in] value The value to extract bits from
+ * @param[in] mask  The bits to extract
+ *
+ * @return The extracted bits
+ */
+inline std::uint64_t Pext(std::uint64_t value, std::uint64_t mask) noexcept {
+#if CHESS_SLIDING_ATTACKS==CHESS_ATTACKS_PEXT
+    return _pext_u64(value, mask);
+#elif defined(__x86_64__) && defined(__GNUC__)
+    // Inline assembly rather than the intrinsic, so that this can be inlined
+    // into code that is not compiled for BMI2
+
+    std::uint64_t result;
+    asm("pextq %2, %1, %0" : "=r"(result) : "r"(value), "r"(mask));
+    return result;
+#else
+    static_cast<void>(value);
+    static_cast<void>(mask);
+    return 0;
+#endif
+}
+
+/**
+ * @brief Check whether sliding attacks should be looked up with PEXT
+ *
+ * @return True to use \ref pext_attacks
+ */
+inline bool UsePext() noexcept {
+#if CHESS_SLIDING_ATTACKS==CHESS_ATTACKS_PEXT
+    return true;
+#elif CHESS_SLIDING_ATTACKS==CHESS_ATTACKS_AUTO && \
+      defined(__x86_64__) && defined(__GNUC__)
+    return use_pext;
+#else
+    return false;
+#endif
+}
+
+}  // namespace detail
 
 /**
  * "Attacks from" bitboard generators for sliding pieces
@@ -33,6 +121,12 @@ std::uint64_t AttacksFrom(Square square, std::uint64_t occupied) {
 template <>
 constexpr std::uint64_t AttacksFrom<Piece::BISHOP>(Square square,
                                                    std::uint64_t occupied) {
+    if (!__builtin_is_constant_evaluated() && detail::UsePext()) {
+        return detail::pext_attacks.bishop[
+            data_tables::kBishopOffsets[square] +
+            detail::Pext(occupied, data_tables::kBishopAttacksMask[square])];
+    }
+
     const std::uint64_t occupied_ =
         data_tables::kBishopAttacksMask[square] & occupied;
 
@@ -47,6 +141,12 @@ constexpr std::uint64_t AttacksFrom<Piece::BISHOP>(Square square,
 template <>
 constexpr std::uint64_t AttacksFrom<Piece::ROOK>(Square square,
                                                  std::uint64_t occupied) {
+    if (!__builtin_is_constant_evaluated() && detail::UsePext()) {
+        return detail::pext_attacks.rook[
+            data_tables::kRookOffsets[square] +
+            detail::Pext(occupied, data_tables::kRookAttacksMask[square])];
+    }
+
     const std::uint64_t occupied_ =
         data_tables::kRookAttacksMask[square] & occupied;
 
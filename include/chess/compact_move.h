@@ -0,0 +1,227 @@
+/**
+ *  \file   compact_move.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#ifndef CHESS_COMPACT_MOVE_H_
+#define CHESS_COMPACT_MOVE_H_
+
+#include <cstdint>
+
+#include "chess/chess.h"
+#include "chess/position.h"
+#include "chess/util.h"
+
+namespace chess {
+/**
+ * @brief A move encoded in 16 bits, for storage where space matters, e.g.
+ *        hash table entries and search tree nodes
+ *
+ * Unlike the 21-bit packed format (see util::PackMove()), the pieces moved
+ * and captured are not recorded; they are recovered from the position the
+ * move is played in. The layout is:
+ *
+ *      15: capture flag (set for en passant)
+ * 14...12: promotion piece, or 0 if none
+ * 11... 6: destination square
+ *  5... 0: origin square
+ */
+class CompactMove final {
+public:
+    constexpr CompactMove() noexcept;
+
+    constexpr explicit CompactMove(std::uint16_t data) noexcept;
+
+    constexpr CompactMove(Square from, Square to, Piece promoted,
+                          bool capture) noexcept;
+
+    CompactMove(const CompactMove& move)            = default;
+    CompactMove(CompactMove&& move)                 = default;
+    CompactMove& operator=(const CompactMove& move) = default;
+    CompactMove& operator=(CompactMove&& move)      = default;
+
+    ~CompactMove() = default;
+
+    static constexpr CompactMove FromPacked(std::uint32_t move) noexcept;
+
+    constexpr std::uint16_t Data() const noexcept;
+
+    constexpr Square From() const noexcept;
+
+    constexpr bool IsCapture() const noexcept;
+
+    constexpr bool IsNull() const noexcept;
+
+    constexpr Piece Promoted() const noexcept;
+
+    constexpr Square To() const noexcept;
+
+    constexpr std::uint32_t ToPacked(const Position& pos) const noexcept;
+
+    friend constexpr bool operator==(CompactMove a, CompactMove b) noexcept;
+    friend constexpr bool operator!=(CompactMove a, CompactMove b) noexcept;
+
+private:
+    /**
+     * The encoded move. Zero is the null move
+     */
+    std::uint16_t data_;
+};
+
+static_assert(sizeof(CompactMove) == 2);
+
+/**
+ * @brief Default constructor. Creates the null move
+ */
+constexpr CompactMove::CompactMove() noexcept : data_(0) {
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param data A move previously obtained from \ref Data()
+ */
+constexpr CompactMove::CompactMove(std::uint16_t data) noexcept
+    : data_(data) {
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param from     The origin square
+ * @param to       The destination square
+ * @param promoted The piece promoted to, or Piece::EMPTY
+ * @param capture  True if this move captures, including en passant
+ */
+constexpr CompactMove::CompactMove(Square from,
+                                   Square to,
+                                   Piece promoted,
+                                   bool capture) noexcept
+    : data_(static_cast<std::uint16_t>(
+          from |
+          (to << 6) |
+          ((promoted == Piece::EMPTY ? 0 : promoted) << 12) |
+          (capture ? 0x8000 : 0))) {
+}
+
+/**
+ * @brief Convert a move from the 21-bit packed format
+ *
+ * @param move The packed move
+ *
+ * @return The compact move, or the null move if \a move is kNullMove
+ */
+constexpr CompactMove CompactMove::FromPacked(std::uint32_t move) noexcept {
+    if (move == kNullMove) return CompactMove();
+
+    return CompactMove(util::ExtractFrom(move),
+                       util::ExtractTo(move),
+                       util::ExtractPromoted(move),
+                       util::ExtractCaptured(move) != Piece::EMPTY);
+}
+
+/**
+ * @brief Get the encoded move, e.g. for storing in a hash table
+ *
+ * @return The move's 16 bits
+ */
+constexpr std::uint16_t CompactMove::Data() const noexcept {
+    return data_;
+}
+
+/**
+ * @brief Get the origin square
+ *
+ * @return The square moved from
+ */
+constexpr Square CompactMove::From() const noexcept {
+    return static_cast<Square>(data_ & 0x3f);
+}
+
+/**
+ * @brief Check whether this move captures
+ *
+ * @return True if a piece is captured, including en passant
+ */
+constexpr bool CompactMove::IsCapture() const noexcept {
+    return (data_ & 0x8000) != 0u;
+}
+
+/**
+ * @brief Check whether this is the null move
+ *
+ * @return True if this is the null move
+ */
+constexpr bool CompactMove::IsNull() const noexcept {
+    return data_ == 0u;
+}
+
+/**
+ * @brief Get the promotion piece
+ *
+ * @return The piece promoted to, or Piece::EMPTY if this is not a promotion
+ */
+constexpr Piece CompactMove::Promoted() const noexcept {
+    const int promoted = (data_ >> 12) & 0x7;
+    return promoted == 0 ? Piece::EMPTY : static_cast<Piece>(promoted);
+}
+
+/**
+ * @brief Get the destination square
+ *
+ * @return The square moved to
+ */
+constexpr Square CompactMove::To() const noexcept {
+    return static_cast<Square>((data_ >> 6) & 0x3f);
+}
+
+/**
+ * @brief Convert this move to the 21-bit packed format, filling in the
+ *        pieces from the position
+ *
+ * @note The result is only meaningful if this move is legal in \a pos.
+ *       Moves from elsewhere (e.g. the hash table) should be checked with
+ *       ValidateMove() afterwards
+ *
+ * @param pos The position this move is played in
+ *
+ * @return The packed move, or kNullMove if this is the null move
+ */
+constexpr std::uint32_t CompactMove::ToPacked(
+        const Position& pos) const noexcept {
+    if (IsNull()) return kNullMove;
+
+    const Piece moved = pos.PieceOn(From());
+    Piece captured = pos.PieceOn(To());
+
+    // An en passant capture lands on an empty square
+
+    if (moved == Piece::PAWN && captured == Piece::EMPTY && IsCapture()) {
+        captured = Piece::PAWN;
+    }
+
+    return util::PackMove(captured, From(), moved, Promoted(), To());
+}
+
+/**
+ * @brief Compare two moves
+ *
+ * @return True if \a a and \a b are the same move
+ */
+constexpr bool operator==(CompactMove a, CompactMove b) noexcept {
+    return a.data_ == b.data_;
+}
+
+/**
+ * @brief Compare two moves
+ *
+ * @return True if \a a and \a b are different moves
+ */
+constexpr bool operator!=(CompactMove a, CompactMove b) noexcept {
+    return a.data_ != b.data_;
+}
+
+}  // namespace chess
+
+#endif  // CHESS_COMPACT_MOVE_H_
@@ -13,8 +13,64 @@
 #include "chess/chess.h"
 #include "chess/private/data_tables_internal.h"
 
+/**
+ * How the large tables (sliding attacks, mobility, rays, 16-bit bit scans)
+ * are built. Constexpr evaluates them at compile time, in every translation
+ * unit that includes this header. Runtime builds them once at startup into a
+ * single aligned arena, and the tables below become references into it
+ */
+#define CHESS_TABLES_CONSTEXPR 0
+#define CHESS_TABLES_RUNTIME   1
+
+#ifndef CHESS_DATA_TABLES
+#define CHESS_DATA_TABLES CHESS_TABLES_CONSTEXPR
+#endif
+
 namespace chess {
 namespace data_tables {
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+namespace internal {
+/**
+ * Storage for the runtime-initialized tables, grouped by how they are read.
+ * Each group starts on its own cache line
+ */
+struct TableArena {
+    /** Sliding attacks, read for every slider during move generation */
+    alignas(64) std::array<std::uint64_t, kAttacksRookDbSize> rook_attacks;
+    alignas(64) std::array<std::uint64_t, kAttacksDiagDbSize> bishop_attacks;
+
+    /** Square pair geometry, read for checks, pins and exchanges */
+    alignas(64) std::array<std::array<std::uint64_t,64>,64> ray_segment;
+    alignas(64) std::array<std::array<std::uint64_t,64>,64> ray_extend;
+    alignas(64) std::array<std::array<std::uint64_t,64>,64> ray;
+    alignas(64) std::array<std::array<Direction,64>,64> directions;
+
+    /** Mobility, indexed like the sliding attacks */
+    alignas(64) std::array<std::uint8_t, kAttacksRookDbSize> rook_mobility;
+    alignas(64) std::array<std::uint8_t, kAttacksDiagDbSize> bishop_mobility;
+
+    /** 16-bit bit scans, no longer on any hot path */
+    alignas(64) std::array<
+        decltype(jfern::bitops::lsb<std::uint16_t>(0)), 65536> lsb;
+    alignas(64) std::array<
+        decltype(jfern::bitops::msb<std::uint16_t>(0)), 65536> msb;
+    alignas(64) std::array<
+        decltype(jfern::bitops::count<std::uint16_t>(0)), 65536> pop;
+};
+
+/**
+ * The tables themselves, filled in during static initialization
+ */
+extern TableArena table_arena;
+
+/**
+ * @brief Fill in \ref table_arena. This runs automatically at startup, and
+ *        may be called again (e.g. to time it)
+ */
+void InitTableArena() noexcept;
+
+}  // namespace internal
+#endif
 
 /**
  * The "3rd" rank, as seen from each player's perspective
@@ -75,7 +131,12 @@ template<> constexpr auto kBackRank<Player::kWhite> = kRank1;
 /**
  * A database containing the "attacks from" bitboards for a bishop
  */
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+inline constexpr const auto& kBishopAttacks =
+    internal::table_arena.bishop_attacks;
+#else
 constexpr auto kBishopAttacks = internal::InitAttacksFromDiag();
+#endif
 
 /**
  * The occupancy squares we mask the occupied squares bitboard with to obtain
@@ -96,7 +157,12 @@ constexpr auto kBishopDbShifts =
  * and occupancy. A higher mobility score indicates the bishop can move to more
  * squares
  */
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+inline constexpr const auto& kBishopMobility =
+    internal::table_arena.bishop_mobility;
+#else
 constexpr auto kBishopMobility = internal::InitMobilityDiag();
+#endif
 
 /**
  * Offset into the \ref bishop_attacks database that marks the start of the
@@ -248,8 +314,13 @@ constexpr auto kDiagMagics = internal::CreateTable<64>(internal::DiagMagic);
  *
  * @note They are NOT connected if they are the same square
  */
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+inline constexpr const auto& kDirections =
+    internal::table_arena.directions;
+#else
 constexpr auto kDirections =
     internal::CreateTable<64,64>(internal::GetDirection);
+#endif
 
 /**
  * All squares "east" of a particular square, from white's perspective
@@ -385,11 +456,21 @@ template<> constexpr auto kKingSide<Player::kBlack> =
 constexpr auto kKnightAttacks =
     internal::CreateTable<64>(internal::InitAttacksFromKnight);
 
+/**
+ * The light squares (h1 is one of them)
+ */
+constexpr std::uint64_t kLightSquares = 0xaa55aa55aa55aa55;
+
 /**
  * Returns the LSB for every possible unsigned 16-bit value
  */
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+inline constexpr const auto& kLsb =
+    internal::table_arena.lsb;
+#else
 constexpr auto kLsb =
     internal::CreateTable<65536>(jfern::bitops::lsb<std::uint16_t>);
+#endif
 
 /**
  * The square arrived at by retreating 2 pawn steps
@@ -470,8 +551,13 @@ template<> constexpr auto kMinus9<Player::kBlack> =
 /**
  * Returns the MSB for every possible unsigned 16-bit value
  */
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+inline constexpr const auto& kMsb =
+    internal::table_arena.msb;
+#else
 constexpr auto kMsb =
     internal::CreateTable<65536>(jfern::bitops::msb<std::uint16_t>);
+#endif
 
 /**
  * All squares "north" of a particular square, from white's perspective
@@ -546,6 +632,28 @@ constexpr std::array<std::int16_t,7> kPieceValue = {{
     }
 };
 
+/**
+ * Positional bonus for a player's piece standing on a square, indexed by
+ * [piece][square]. Position keeps the sum of these up to date as pieces move
+ *
+ * @{
+ */
+
+template <Player P>
+constexpr auto kPieceSquare = std::array<std::array<std::int16_t,64>,7>();
+
+template<>
+constexpr auto kPieceSquare<Player::kWhite> =
+    internal::InitPieceSquare<Player::kWhite>();
+
+template<>
+constexpr auto kPieceSquare<Player::kBlack> =
+    internal::InitPieceSquare<Player::kBlack>();
+
+/**
+ * @}
+ */
+
 /**
  * The square arrived at by advancing 2 pawn steps
  *
@@ -625,8 +733,13 @@ template<> constexpr auto kPlus9<Player::kBlack> =
 /**
  * Returns the population count for every possible unsigned 16-bit value
  */
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+inline constexpr const auto& kPop =
+    internal::table_arena.pop;
+#else
 constexpr auto kPop =
     internal::CreateTable<65536>(jfern::bitops::count<std::uint16_t>);
+#endif
 
 /**
  * Bitmasks representing the queenside
@@ -668,7 +781,12 @@ constexpr auto kRanks64 = internal::CreateTable<64>(util::GetRankMask);
  * Describes a ray whose origin is at the 1st index and extends to the end of
  * the board through the 2nd
  */
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+inline constexpr const auto& kRay =
+    internal::table_arena.ray;
+#else
 constexpr auto kRay = internal::CreateTable<64,64>(internal::InitRay);
+#endif
 
 /**
  * Similar to kRaySegment, but includes the entire "line" along that direction,
@@ -676,20 +794,35 @@ constexpr auto kRay = internal::CreateTable<64,64>(internal::InitRay);
  *
  * kRayExtend[B2][C3] = entire A1-H8 diagonal
  */
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+inline constexpr const auto& kRayExtend =
+    internal::table_arena.ray_extend;
+#else
 constexpr auto kRayExtend =
     internal::CreateTable<64,64>(internal::InitRayExtend);
+#endif
 
 /**
  * Represents all squares located between any two squares, but excluding those
  * two squares
  */
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+inline constexpr const auto& kRaySegment =
+    internal::table_arena.ray_segment;
+#else
 constexpr auto kRaySegment =
     internal::CreateTable<64,64>(internal::InitRaySegment);
+#endif
 
 /**
  * A database containing the "attacks from" bitboards for a rook
  */
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+inline constexpr const auto& kRookAttacks =
+    internal::table_arena.rook_attacks;
+#else
 constexpr auto kRookAttacks = internal::InitAttacksFromRook();
+#endif
 
 /**
  * The occupancy squares we mask the occupied squares bitboard with to obtain
@@ -736,7 +869,12 @@ constexpr auto kRookMagics = internal::CreateTable<64>(internal::RookMagic);
  * and occupancy. A higher mobility score indicates the rook can move to more
  * squares
  */
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+inline constexpr const auto& kRookMobility =
+    internal::table_arena.rook_mobility;
+#else
 constexpr auto kRookMobility = internal::InitMobilityRook();
+#endif
 
 /**
  * Offset into the \ref rook_attacks database that marks the start of the
@@ -781,6 +919,45 @@ constexpr auto kSouthWestMask =
  */
 constexpr auto kWestMask = internal::CreateTable<64>(internal::WestMask);
 
+/**
+ * Zobrist keys for every combination of castling rights
+ *
+ * @see internal::ZobristCastle()
+ */
+constexpr auto kZobristCastle =
+    internal::CreateTable<16>(internal::ZobristCastle);
+
+/**
+ * Zobrist keys for the en passant target, indexed by file
+ */
+constexpr auto kZobristEnPassant =
+    internal::CreateTable<8>(internal::ZobristEnPassant);
+
+/**
+ * Zobrist keys for each player's pieces, indexed by [piece][square]
+ *
+ * @{
+ */
+
+template <Player P>
+auto kZobristPiece = std::array<std::array<std::uint64_t,64>,6>();
+
+template<> constexpr auto kZobristPiece<Player::kWhite> =
+    internal::CreateTable<6,64>(internal::ZobristPiece<Player::kWhite>);
+
+template<> constexpr auto kZobristPiece<Player::kBlack> =
+    internal::CreateTable<6,64>(internal::ZobristPiece<Player::kBlack>);
+
+/**
+ * @}
+ */
+
+/**
+ * Zobrist key folded into the hash signature when Black is on move
+ */
+constexpr std::uint64_t kZobristToMove =
+    internal::ZobristKey(internal::kZobristToMoveIndex);
+
 }  // namespace data_tables
 }  // namespace chess
 
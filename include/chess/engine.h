@@ -8,34 +8,42 @@
 #define CHESS_ENGINE_H_
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <thread>
 
 #include "chess/engine_interface.h"
+#include "chess/game_history.h"
 #include "chess/logger.h"
 #include "chess/memory_pool.h"
 #include "chess/movegen.h"
 #include "chess/mtcs.h"
 #include "chess/stream_channel.h"
 #include "chess/position.h"
+#include "chess/time_manager.h"
 
 namespace chess {
 /**
  * @brief UCI chess engine
+ *
+ * Searches run on a dedicated thread, so that commands such as "isready" and
+ * "stop" are handled while the engine is thinking
  */
 class Engine final : public EngineInterface {
 public:
     Engine(std::shared_ptr<OutputStreamChannel> channel,
            std::shared_ptr<Logger> logger);
 
-    Engine(const Engine& engine) = default;
-    Engine(Engine&& engine) = default;
-    Engine& operator=(const Engine& engine) = default;
-    Engine& operator=(Engine&& engine) = default;
+    Engine(const Engine& engine) = delete;
+    Engine(Engine&& engine) = delete;
+    Engine& operator=(const Engine& engine) = delete;
+    Engine& operator=(Engine&& engine) = delete;
 
-    ~Engine() = default;
+    ~Engine();
 
     void Uci() noexcept override;
     void DebugMode(bool enable) noexcept override;
@@ -44,7 +52,7 @@ public:
                    const std::vector<std::string>& args) noexcept override;
     void UciNewGame() noexcept override;
     bool Position (const std::vector<std::string>& args) noexcept override;
-    void Go() noexcept override;
+    void Go(const SearchLimits& limits) noexcept override;
     void Stop() noexcept override;
     void PonderHit() noexcept override;
 
@@ -52,6 +60,12 @@ private:
     template <Player P>
     std::int16_t Search(std::uint32_t* bestmove);
 
+    /**
+     * The time at which the last "bestmove" was sent. Written by the search
+     * thread
+     */
+    std::chrono::steady_clock::time_point bestmove_time_;
+
     /**
      * Channel through which to emit UCI outputs
      */
@@ -63,10 +77,16 @@ private:
      */
     bool debug_mode_;
 
+    /**
+     * The positions played in the game before \ref master_, since the last
+     * irreversible move
+     */
+    GameHistory game_history_;
+
     /**
      * True if a calculation is in progress
      */
-    bool is_running_;
+    std::atomic<bool> is_running_;
 
     /**
      * Object through which to log internal info
@@ -83,10 +103,26 @@ private:
      */
     std::shared_ptr<MemoryPool<Mtcs::Node>>
         mem_pool_;
+
+    /**
+     * The search algorithm. Kept between searches so that its tree can be
+     * reused as the game progresses
+     */
+    std::shared_ptr<Mtcs> mtcs_;
+
+    /**
+     * The thread running the current (or last) search
+     */
+    std::thread search_thread_;
+
+    /**
+     * Sets the deadlines of each search
+     */
+    std::shared_ptr<TimeManager> time_manager_;
 };
 
 /**
- * Find the best move given the current position
+ * Find the best move given the current position. Runs on the search thread
  *
  * @param[out] bestmove The best move found by the search
  *
@@ -100,22 +136,8 @@ std::int16_t Engine::Search(std::uint32_t* bestmove) {
             GenerateCheckEvasions<P>(master_, moves.data()) :
                GenerateLegalMoves<P>(master_, moves.data());
 
-    logger_->Write("Node size = %zu\n", sizeof(Mtcs::Node));
-
-    auto mtcs_log = std::make_shared<Logger>("MTCS", channel_);
-
-    if (!mem_pool_) {
-        auto mem_log = std::make_shared<Logger>("MemoryPool", channel_);
-
-        mem_pool_ = std::make_shared<MemoryPool<Mtcs::Node>>(100000000, mem_log);
-    } else {
-        mem_pool_->Free();
-    }
-
-    auto mtcs = std::make_shared<Mtcs>(mem_pool_, mtcs_log);
-
-    auto result = mtcs->Run(master_);
-    mtcs_log->Write("Analysis: %s\n", util::ToLongAlgebraic(result).c_str());
+    auto result = mtcs_->Run(master_);
+    logger_->Write("Analysis: %s\n", util::ToLongAlgebraic(result).c_str());
 
     *bestmove = n_moves == 0 ? 0 : result;
 
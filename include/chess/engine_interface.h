@@ -10,6 +10,8 @@
 #include <string>
 #include <vector>
 
+#include "chess/time_manager.h"
+
 namespace chess {
 /**
  * @brief Interface used by a UciProtocol to make requests to the engine
@@ -27,7 +29,7 @@ public:
                            const std::vector<std::string>& args) noexcept = 0;
     virtual void UciNewGame() noexcept = 0;
     virtual bool Position (const std::vector<std::string>& args) noexcept = 0;
-    virtual void Go() noexcept = 0;
+    virtual void Go(const SearchLimits& limits) noexcept = 0;
     virtual void Stop() noexcept = 0;
     virtual void PonderHit() noexcept = 0;
 };
@@ -7,12 +7,122 @@
 #ifndef CHESS_EVALUATE_H_
 #define CHESS_EVALUATE_H_
 
+#include <cstdint>
+
+#include "chess/attacks.h"
 #include "chess/chess.h"
+#include "chess/data_tables.h"
 #include "chess/position.h"
+#include "chess/util.h"
 
 namespace chess {
 Result GameResult(const Position& pos);
 
+/**
+ * @brief Count the squares a player's sliding pieces can move to. Unlike
+ *        material and piece-square bonuses this depends on every other
+ *        piece, so it is computed from scratch
+ *
+ * @tparam P The player whose bishops, rooks and queens to count for
+ *
+ * @param pos The position to evaluate
+ *
+ * @return The number of empty or enemy squares attacked by the sliders
+ */
+template <Player P>
+int SliderMobility(const Position& pos) noexcept {
+    const auto& info = pos.GetPlayerInfo<P>();
+
+    const std::uint64_t occupied = pos.Occupied();
+    const std::uint64_t targets  = ~info.Occupied();
+
+    int mobility = 0;
+
+    for (std::uint64_t pieces = info.Bishops() | info.Queens(); pieces; ) {
+        const auto from = static_cast<Square>(util::Msb(pieces));
+        pieces &= data_tables::kClearMask[from];
+
+        mobility += util::BitCount(
+            AttacksFrom<Piece::BISHOP>(from, occupied) & targets);
+    }
+
+    for (std::uint64_t pieces = info.Rooks() | info.Queens(); pieces; ) {
+        const auto from = static_cast<Square>(util::Msb(pieces));
+        pieces &= data_tables::kClearMask[from];
+
+        mobility += util::BitCount(
+            AttacksFrom<Piece::ROOK>(from, occupied) & targets);
+    }
+
+    return mobility;
+}
+
+/**
+ * @brief Static evaluation: material, piece-square bonuses and the mobility
+ *        of sliding pieces, one centipawn per square
+ *
+ * Material and piece-square sums are maintained by the position as moves are
+ * made, so only mobility is computed here
+ *
+ * @tparam P The player to evaluate for
+ *
+ * @param pos The position to evaluate
+ *
+ * @return The score in centipawns from the perspective of \a P
+ */
+template <Player P>
+int Evaluate(const Position& pos) noexcept {
+    constexpr Player O = util::opponent<P>();
+
+    const auto& us   = pos.GetPlayerInfo<P>();
+    const auto& them = pos.GetPlayerInfo<O>();
+
+    return us.Material()    - them.Material()    +
+           us.PieceSquare() - them.PieceSquare() +
+           SliderMobility<P>(pos) - SliderMobility<O>(pos);
+}
+
+/**
+ * @brief Static evaluation from the perspective of the player to move
+ *
+ * @param pos The position to evaluate
+ *
+ * @return The score in centipawns
+ */
+inline int Evaluate(const Position& pos) noexcept {
+    return pos.ToMove() == Player::kWhite ? Evaluate<Player::kWhite>(pos) :
+                                            Evaluate<Player::kBlack>(pos);
+}
+
+/**
+ * @brief Check whether neither player has enough material to checkmate,
+ *        i.e. only kings remain plus either a single minor piece or any
+ *        number of bishops all on squares of one color
+ *
+ * @param pos The position to check
+ *
+ * @return True if the game is drawn by insufficient material
+ */
+inline bool IsInsufficientMaterial(const Position& pos) noexcept {
+    const auto& white = pos.GetPlayerInfo<Player::kWhite>();
+    const auto& black = pos.GetPlayerInfo<Player::kBlack>();
+
+    if (white.Pawns()  | black.Pawns()  |
+        white.Rooks()  | black.Rooks()  |
+        white.Queens() | black.Queens()) {
+        return false;
+    }
+
+    const std::uint64_t knights = white.Knights() | black.Knights();
+    const std::uint64_t bishops = white.Bishops() | black.Bishops();
+
+    if (util::BitCount(knights | bishops) <= 1) return true;
+
+    return knights == 0u &&
+        ((bishops &  data_tables::kLightSquares) == 0u ||
+         (bishops & ~data_tables::kLightSquares) == 0u);
+}
+
 /**
  * @brief Check if the game has been lost by the specified player
  *
@@ -0,0 +1,164 @@
+/**
+ *  \file   game_history.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#ifndef CHESS_GAME_HISTORY_H_
+#define CHESS_GAME_HISTORY_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "chess/chess.h"
+#include "chess/evaluate.h"
+#include "chess/position.h"
+
+namespace chess {
+/**
+ * @brief The hash signatures of the positions leading up to the current
+ *        one, for detecting draws by repetition
+ *
+ * The engine seeds this with the moves of the game so far. A search then
+ * takes a copy, pushing the hash of each position it moves out of and
+ * popping it again on the way back up the tree
+ */
+class GameHistory final {
+public:
+    /**
+     * The number of reversible plies after which the fifty-move rule
+     * applies
+     */
+    static constexpr int kFiftyMovePlies = 100;
+
+    GameHistory();
+
+    GameHistory(const GameHistory& history)            = default;
+    GameHistory(GameHistory&& history)                 = default;
+    GameHistory& operator=(const GameHistory& history) = default;
+    GameHistory& operator=(GameHistory&& history)      = default;
+
+    ~GameHistory() = default;
+
+    void Clear() noexcept;
+
+    bool IsDraw(const Position& pos, std::size_t ply) const;
+
+    bool IsRepetition(const Position& pos, std::size_t ply) const noexcept;
+
+    void Pop() noexcept;
+
+    void Push(std::uint64_t hash);
+
+    std::size_t Size() const noexcept;
+
+private:
+    /**
+     * Hash signatures, oldest first. The last one belongs to the parent of
+     * the current position
+     */
+    std::vector<std::uint64_t> hashes_;
+};
+
+/**
+ * @brief Constructor. Reserves enough room that a search never needs to
+ *        allocate
+ */
+inline GameHistory::GameHistory() : hashes_() {
+    hashes_.reserve(2 * kMaxPly);
+}
+
+/**
+ * @brief Forget all positions, e.g. for a new game or after an irreversible
+ *        move, since no earlier position can occur again
+ */
+inline void GameHistory::Clear() noexcept {
+    hashes_.clear();
+}
+
+/**
+ * @brief Check whether a position in the search is a draw by repetition,
+ *        the fifty-move rule or insufficient material
+ *
+ * @param pos The current position
+ * @param ply Distance of \a pos from the search root
+ *
+ * @return True if \a pos should be scored as a draw
+ */
+inline bool GameHistory::IsDraw(const Position& pos, std::size_t ply) const {
+    if (pos.HalfMoveNumber() >= kFiftyMovePlies) {
+        // Checkmate on the last ply takes precedence. This needs move
+        // generation but is rarely reached
+
+        const Result result = GameResult(pos);
+        return result == Result::kDraw || result == Result::kGameNotOver;
+    }
+
+    return IsRepetition(pos, ply) || IsInsufficientMaterial(pos);
+}
+
+/**
+ * @brief Check whether a position repeats an earlier one
+ *
+ * Only positions since the last irreversible move can repeat, so the
+ * scan is bounded by the half move number
+ *
+ * A single repetition within the search is treated as a draw, since the
+ * player who allowed it could just as well repeat again. A position seen
+ * only before the root must have occurred twice
+ *
+ * @param pos The current position
+ * @param ply Distance of \a pos from the search root
+ *
+ * @return True if the position is drawn by repetition
+ */
+inline bool GameHistory::IsRepetition(const Position& pos,
+                                      std::size_t ply) const noexcept {
+    const std::size_t reversible =
+        std::min<std::size_t>(pos.HalfMoveNumber(), hashes_.size());
+
+    int count = 0;
+
+    // The same player is to move every other ply, and it takes at least four
+    // plies to return to a position
+
+    for (std::size_t distance = 4; distance <= reversible; distance += 2) {
+        if (hashes_[hashes_.size() - distance] == pos.Hash()) {
+            if (distance < ply || ++count == 2) return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Remove the most recent position, when a move is unmade
+ */
+inline void GameHistory::Pop() noexcept {
+    hashes_.pop_back();
+}
+
+/**
+ * @brief Record a position, before a move is made from it
+ *
+ * @param hash The hash signature of the position
+ */
+inline void GameHistory::Push(std::uint64_t hash) {
+    hashes_.push_back(hash);
+}
+
+/**
+ * @brief Get the number of positions recorded
+ *
+ * @return The number of plies since the history was last cleared, plus
+ *         those of the current search
+ */
+inline std::size_t GameHistory::Size() const noexcept {
+    return hashes_.size();
+}
+
+}  // namespace chess
+
+#endif  // CHESS_GAME_HISTORY_H_
@@ -7,6 +7,7 @@
 #ifndef CHESS_LOG_H_
 #define CHESS_LOG_H_
 
+#include <array>
 #include <ctime>
 #include <iterator>
 #include <memory>
@@ -18,6 +19,8 @@
 namespace chess {
 /**
  * @brief Logs messages from an individual engine component
+ *
+ * Write() may be called from several threads at once
  */
 class Logger final {
 public:
@@ -48,11 +51,6 @@ private:
      * The name of this log source
      */
     std::string name_;
-
-    /**
-     * Buffer sized to contain message prefix
-     */
-    std::string prefix_buffer_;
 };
 
 /**
@@ -62,12 +60,21 @@ private:
  */
 template <typename... Ts>
 void Logger::Write(const char* format, Ts&&... args) noexcept {
-    std::time_t time = std::time({});
-    std::strftime(prefix_buffer_.data(), prefix_buffer_.size(),
-                  "%F %T GMT", std::gmtime(&time));
+    std::array<char, 32> time_buffer;
+
+    std::tm time_info;
+    const std::time_t time = std::time({});
+
+    std::strftime(time_buffer.data(), time_buffer.size(), "%F %T GMT",
+                  gmtime_r(&time, &time_info));
+
+    // Emit the prefix and message together, so that messages logged by
+    // different threads are not interleaved
+
+    const std::string prefixed = std::string("%s (%s): ") + format;
 
-    channel_->Write("%s (%s): ", prefix_buffer_.c_str(), name_.c_str());
-    channel_->Write(format, std::forward<Ts>(args)...);
+    channel_->Write(prefixed.c_str(), time_buffer.data(), name_.c_str(),
+                    std::forward<Ts>(args)...);
     channel_->Flush();
 }
 
@@ -10,13 +10,22 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "chess/logger.h"
 
 namespace chess {
 /**
- * @brief A simple memory pool from which individual objects of a particular
- *        type are allocated
+ * @brief A simple memory pool from which objects of a particular type, or
+ *        contiguous arrays of them, are allocated
+ *
+ * Memory is handed out from the front of the pool until it is used up.
+ * Freed arrays are kept on a free list per array length, from which an
+ * allocation of the same length is served first. An allocation with no exact
+ * match is split off a longer free array
+ *
+ * Allocation and deallocation are thread-safe
  *
  * @tparam T The type allocated on each call to Allocate()
  */
@@ -36,10 +45,14 @@ public:
 
     T* Allocate();
 
+    T* Allocate(std::size_t n);
+
     void Free();
 
     bool Free(T* address);
 
+    bool Free(T* address, std::size_t n);
+
     bool Full() const;
 
     std::size_t InUse() const;
@@ -47,7 +60,9 @@ public:
     std::size_t Size() const;
 
 private:
-    void Initialize();
+    std::uint8_t* Pop(std::size_t n);
+
+    void Push(std::uint8_t* address, std::size_t n);
 
     /**
      * Underlying storage for the memory pool
@@ -55,19 +70,30 @@ private:
     std::uint8_t* data_;
 
     /**
-     * The head of the memory pool
+     * Free arrays, indexed by length. Each free array stores the address of
+     * the next one of the same length in its first bytes
      */
-    std::uint8_t* head_;
+    std::vector<std::uint8_t*> free_lists_;
 
     /**
      * The number of bytes currently in use
      */
     std::size_t in_use_;
 
+    /**
+     * Guards the free lists
+     */
+    mutable std::mutex mutex_;
+
     /**
      * The total pool size, in bytes
      */
     std::size_t size_;
+
+    /**
+     * The start of the memory which has never been allocated
+     */
+    std::uint8_t* top_;
 };
 
 /**
@@ -79,16 +105,19 @@ private:
 template <typename T>
 MemoryPool<T>::MemoryPool(std::size_t size,
                           std::shared_ptr<Logger> logger)
-    : data_(nullptr), head_(nullptr), in_use_(0u), size_(0u) {
+    : data_(nullptr),
+      free_lists_(),
+      in_use_(0u),
+      mutex_(),
+      size_(0u),
+      top_(nullptr) {
     const std::size_t n_elements = size / sizeof(T);
 
     if (n_elements > 0) {
         size_ = n_elements * sizeof(T);
 
         data_ = new std::uint8_t[size_];
-        head_ = data_;
-
-        Initialize();
+        top_ = data_;
     }
 
     logger->Write("Allocated %zu elements in %zu bytes (%zu requested)\n",
@@ -112,17 +141,50 @@ MemoryPool<T>::~MemoryPool() {
  */
 template <typename T>
 T* MemoryPool<T>::Allocate() {
-    if (Full()) return nullptr;
+    return Allocate(1);
+}
 
-    T* entry = reinterpret_cast<T*>(head_);
+/**
+ * @brief Allocate a contiguous array of elements
+ *
+ * @tparam T The data type of allocated/deallocated elements
+ *
+ * @param n The number of elements
+ *
+ * @return Address of the first element, or nullptr if there is no free
+ *         run of \a n elements
+ */
+template <typename T>
+T* MemoryPool<T>::Allocate(std::size_t n) {
+    if (n == 0u) return nullptr;
 
-    auto next = reinterpret_cast<std::uint8_t**>(head_);
+    const std::size_t bytes = n * sizeof(T);
 
-    head_ = *next;
+    std::lock_guard<std::mutex> lock(mutex_);
 
-    in_use_ += sizeof(T);
+    if ((in_use_ + bytes) > size_) return nullptr;
 
-    return entry;
+    std::uint8_t* entry = Pop(n);
+
+    if (entry == nullptr && bytes <= std::size_t(data_ + size_ - top_)) {
+        entry = top_;
+        top_ += bytes;
+    }
+
+    // Split a longer free array, returning the remainder to the pool
+
+    for (std::size_t m = n+1; entry == nullptr && m < free_lists_.size();
+         m++) {
+        entry = Pop(m);
+
+        if (entry != nullptr) Push(entry + bytes, m - n);
+    }
+
+    if (entry == nullptr) return nullptr;
+
+    in_use_ += bytes;
+
+    return reinterpret_cast<T*>(entry);
 }
 
 /**
@@ -132,10 +194,11 @@ T* MemoryPool<T>::Allocate() {
  */
 template <typename T>
 void MemoryPool<T>::Free() {
-    head_ = data_;
-    in_use_ = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
 
-    Initialize();
+    free_lists_.clear();
+    in_use_ = 0;
+    top_ = data_;
 }
 
 /**
@@ -151,25 +214,39 @@ void MemoryPool<T>::Free() {
  */
 template <typename T>
 bool MemoryPool<T>::Free(T* address) {
+    return Free(address, 1);
+}
+
+/**
+ * @brief Free an array of elements
+ *
+ * @note Double-free causes undefined behavior
+ *
+ * @tparam T The data type of allocated/deallocated elements
+ *
+ * @param address Address of the first element, as returned by Allocate()
+ * @param n       The number of elements allocated
+ *
+ * @return True on success
+ */
+template <typename T>
+bool MemoryPool<T>::Free(T* address, std::size_t n) {
     const std::uint8_t* end = data_ + size_;
 
     const auto freed = reinterpret_cast<std::uint8_t*>(address);
 
-    if (freed < data_ || freed >= end) {
+    if (n == 0u || freed < data_ || freed + n * sizeof(T) > end) {
         return false;
     }
 
-    std::uint8_t* prev_head = head_;
-
-    head_ = reinterpret_cast<std::uint8_t*>(address);
+    std::lock_guard<std::mutex> lock(mutex_);
 
-    *reinterpret_cast<std::uint8_t**>(head_) = prev_head;
+    Push(freed, n);
 
-    in_use_ -= sizeof(T);
+    in_use_ -= n * sizeof(T);
 
     return true;
 }
-
 /**
  * @brief Check if the memory pool is used up
  *
@@ -179,6 +256,7 @@ bool MemoryPool<T>::Free(T* address) {
  */
 template <typename T>
 bool MemoryPool<T>::Full() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return (in_use_ + sizeof(T)) > size_;
 }
 
@@ -191,6 +269,7 @@ bool MemoryPool<T>::Full() const {
  */
 template <typename T>
 std::size_t MemoryPool<T>::InUse() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return in_use_;
 }
 
@@ -207,22 +286,38 @@ std::size_t MemoryPool<T>::Size() const {
 }
 
 /**
- * @brief Initialize internal data structures
+ * @brief Take an array from the free list for its length. The caller must
+ *        hold \ref mutex_
+ *
+ * @param n The array length
+ *
+ * @return The array, or nullptr if none of length \a n is free
  */
 template <typename T>
-void MemoryPool<T>::Initialize() {
-    const std::size_t n_elements = size_ / sizeof(T);
+std::uint8_t* MemoryPool<T>::Pop(std::size_t n) {
+    if (n >= free_lists_.size() || free_lists_[n] == nullptr) return nullptr;
+
+    std::uint8_t* entry = free_lists_[n];
+
+    free_lists_[n] = *reinterpret_cast<std::uint8_t**>(entry);
 
-    for (std::size_t i = 0; i < n_elements; i++) {
-        std::uint8_t* entry = data_ + i * sizeof(T);
+    return entry;
+}
 
-        auto current = reinterpret_cast<std::uint8_t**>(entry);
+/**
+ * @brief Add an array to the free list for its length. The caller must hold
+ *        \ref mutex_
+ *
+ * @param address The first byte of the array
+ * @param n       The array length
+ */
+template <typename T>
+void MemoryPool<T>::Push(std::uint8_t* address, std::size_t n) {
+    if (n >= free_lists_.size()) free_lists_.resize(n+1, nullptr);
 
-        std::uint8_t* next =
-            (i == n_elements-1) ? nullptr : (entry +sizeof(T));
+    *reinterpret_cast<std::uint8_t**>(address) = free_lists_[n];
 
-        *current = next;
-    }
+    free_lists_[n] = address;
 }
 
 }  // namespace chess
@@ -0,0 +1,472 @@
+/**
+ *  \file   move_picker.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#ifndef CHESS_MOVE_PICKER_H_
+#define CHESS_MOVE_PICKER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "chess/chess.h"
+#include "chess/data_tables.h"
+#include "chess/movegen.h"
+#include "chess/position.h"
+#include "chess/scored_move_list.h"
+#include "chess/static_exchange.h"
+#include "chess/util.h"
+
+namespace chess {
+/**
+ * @brief Hands out the legal moves of a position one at a time, best first,
+ *        generating each group of moves only when it is needed
+ *
+ * Outside of check the stages are:
+ *
+ * 1. The hash move
+ * 2. Captures and promotions that do not lose material, by most valuable
+ *    victim/least valuable attacker (MVV/LVA)
+ * 3. Killer moves
+ * 4. The remaining quiet moves, by history score
+ * 5. Captures that lose material according to static exchange evaluation
+ *
+ * The hash and killer moves are checked with ValidateMove() rather than
+ * generated, so a beta cutoff on any of them or on a capture skips quiet
+ * move generation altogether. In check, all evasions are generated at once
+ * and ordered the same way. The quiescence constructor stops after stage 2,
+ * optionally followed by quiet moves which give check
+ *
+ * @tparam P The player whose turn it is
+ */
+template <Player P>
+class MovePicker final {
+public:
+    /**
+     * History scores indexed by origin and destination
+     */
+    using History = std::array<std::array<std::int32_t, 64>, 64>;
+
+    /**
+     * The stages, in the order they are visited. The checks stages are only
+     * visited in quiescence, right after the good captures
+     */
+    enum class Stage {
+        kHashMove,
+        kGenerateCaptures,
+        kGoodCaptures,
+        kKillers,
+        kGenerateQuiets,
+        kQuiets,
+        kBadCaptures,
+        kGenerateChecks,
+        kChecks,
+        kGenerateEvasions,
+        kEvasions,
+        kDone
+    };
+
+    /**
+     * Move ordering scores. Within the capture band, captures are ordered by
+     * MVV/LVA
+     */
+    static constexpr std::int32_t kHashMoveScore = 1 << 30;
+    static constexpr std::int32_t kCaptureScore  = 1 << 24;
+    static constexpr std::int32_t kKillerScore   = 1 << 23;
+
+    MovePicker(Position* position,
+               std::uint32_t hash_move,
+               const std::array<std::uint32_t, 2>& killers,
+               const History& history) noexcept;
+
+    MovePicker(Position* position, const History& history,
+               bool checks) noexcept;
+
+    MovePicker(const MovePicker& picker)            = delete;
+    MovePicker(MovePicker&& picker)                 = delete;
+    MovePicker& operator=(const MovePicker& picker) = delete;
+    MovePicker& operator=(MovePicker&& picker)      = delete;
+
+    ~MovePicker() = default;
+
+    std::uint32_t Next() noexcept;
+
+    Stage GetStage() const noexcept;
+
+private:
+    static std::int32_t CaptureScore(std::uint32_t move) noexcept;
+
+    static bool IsCapture(std::uint32_t move) noexcept;
+
+    bool IsGoodCapture(std::uint32_t move) noexcept;
+
+    std::int32_t QuietScore(std::uint32_t move) const noexcept;
+
+    /**
+     * The index of the next losing capture to return
+     */
+    std::size_t bad_index_;
+
+    /**
+     * Captures that were generated, with their ordering scores. Losing
+     * captures are moved to the front as they are found
+     */
+    ScoredMoveList captures_;
+
+    /**
+     * The index of the next capture to consider
+     */
+    std::size_t capture_index_;
+
+    /**
+     * If true, quiet moves and losing captures are never returned
+     */
+    bool captures_only_;
+
+    /**
+     * If true, quiet moves which give check follow the captures in
+     * quiescence
+     */
+    bool checks_;
+
+    /**
+     * The move from the transposition table, or kNullMove if it is not legal
+     */
+    std::uint32_t hash_move_;
+
+    /**
+     * History scores for \a P
+     */
+    const History& history_;
+
+    /**
+     * The index of the next killer move to try
+     */
+    std::size_t killer_index_;
+
+    /**
+     * Quiet moves which recently caused a beta cutoff at this ply
+     */
+    std::array<std::uint32_t, 2> killers_;
+
+    /**
+     * The number of losing captures
+     */
+    std::size_t n_bad_;
+
+    /**
+     * The pieces pinned on our king
+     */
+    std::uint64_t pinned_;
+
+    /**
+     * The position to pick moves for
+     */
+    Position* position_;
+
+    /**
+     * Quiet moves (or evasions, when in check) that were generated, with
+     * their ordering scores
+     */
+    ScoredMoveList quiets_;
+
+    /**
+     * The index of the next quiet move to consider
+     */
+    std::size_t quiet_index_;
+
+    /**
+     * The current stage
+     */
+    Stage stage_;
+};
+
+/**
+ * @brief Constructor for the main search
+ *
+ * @param position  The position to pick moves for. It is modified while
+ *                  evaluating captures but always restored
+ * @param hash_move The move stored in the transposition table, if any
+ * @param killers   The killer moves at this ply
+ * @param history   History scores for \a P
+ */
+template <Player P>
+MovePicker<P>::MovePicker(Position* position,
+                          std::uint32_t hash_move,
+                          const std::array<std::uint32_t, 2>& killers,
+                          const History& history) noexcept
+    : bad_index_(0),
+      capture_index_(0),
+      captures_only_(false),
+      checks_(false),
+      hash_move_(hash_move),
+      history_(history),
+      killer_index_(0),
+      killers_(killers),
+      n_bad_(0),
+      pinned_(0),
+      position_(position),
+      quiet_index_(0),
+      stage_(Stage::kHashMove) {
+    if (position->InCheck<P>()) {
+        stage_ = Stage::kGenerateEvasions;
+    } else {
+        pinned_ = position->PinnedPieces<P>();
+    }
+}
+
+/**
+ * @brief Constructor for the quiescence search. Only captures and
+ *        promotions which do not lose material are returned, or all
+ *        evasions when in check
+ *
+ * @param position The position to pick moves for
+ * @param history  History scores for \a P, used to order evasions
+ * @param checks   If true, also return quiet moves which give check
+ */
+template <Player P>
+MovePicker<P>::MovePicker(Position* position,
+                          const History& history,
+                          bool checks) noexcept
+    : MovePicker(position, kNullMove, {kNullMove, kNullMove}, history) {
+    captures_only_ = true;
+    checks_ = checks;
+}
+
+/**
+ * @brief Get the next move
+ *
+ * @return The next legal move, or kNullMove once all moves have been
+ *         returned
+ */
+template <Player P>
+std::uint32_t MovePicker<P>::Next() noexcept {
+    while (true) {
+        switch (stage_) {
+          case Stage::kHashMove:
+            stage_ = Stage::kGenerateCaptures;
+
+            if (hash_move_ != kNullMove &&
+                ValidateMove<P>(*position_, hash_move_)) {
+                return hash_move_;
+            }
+
+            hash_move_ = kNullMove;
+            break;
+
+          case Stage::kGenerateCaptures:
+            captures_.Resize(GenerateCaptures<P>(*position_, pinned_,
+                                                 captures_.Data()));
+
+            for (std::size_t i = 0; i < captures_.Size(); i++) {
+                captures_.Score(i) = CaptureScore(captures_.Move(i));
+            }
+
+            stage_ = Stage::kGoodCaptures;
+            break;
+
+          case Stage::kGoodCaptures:
+            while (capture_index_ < captures_.Size()) {
+                const std::uint32_t move =
+                    captures_.PickBest(capture_index_++);
+
+                if (move == hash_move_) continue;
+
+                if (IsGoodCapture(move)) return move;
+
+                // Moves [0, capture_index_) have all been returned or
+                // deferred, so this slot is free
+
+                captures_.Move(n_bad_++) = move;
+            }
+
+            if (!captures_only_) {
+                stage_ = Stage::kKillers;
+            } else {
+                stage_ = checks_ ? Stage::kGenerateChecks : Stage::kDone;
+            }
+            break;
+
+          case Stage::kKillers:
+            while (killer_index_ < killers_.size()) {
+                const std::uint32_t move = killers_[killer_index_++];
+
+                if (move != kNullMove && move != hash_move_ &&
+                    !IsCapture(move) && ValidateMove<P>(*position_, move)) {
+                    return move;
+                }
+            }
+
+            stage_ = Stage::kGenerateQuiets;
+            break;
+
+          case Stage::kGenerateQuiets:
+            quiets_.Resize(GenerateNonCaptures<P>(*position_, pinned_,
+                                                  quiets_.Data()));
+
+            for (std::size_t i = 0; i < quiets_.Size(); i++) {
+                quiets_.Score(i) = QuietScore(quiets_.Move(i));
+            }
+
+            stage_ = Stage::kQuiets;
+            break;
+
+          case Stage::kQuiets:
+            while (quiet_index_ < quiets_.Size()) {
+                const std::uint32_t move = quiets_.PickBest(quiet_index_++);
+
+                // Killers were either returned already or are not legal
+
+                if (move != hash_move_ && move != killers_[0] &&
+                    move != killers_[1]) {
+                    return move;
+                }
+            }
+
+            stage_ = Stage::kBadCaptures;
+            break;
+
+          case Stage::kBadCaptures:
+            if (bad_index_ < n_bad_) return captures_.Move(bad_index_++);
+
+            stage_ = Stage::kDone;
+            break;
+
+          case Stage::kGenerateChecks:
+            quiets_.Resize(GenerateChecks<P>(*position_, pinned_,
+                                             quiets_.Data()));
+            stage_ = Stage::kChecks;
+            break;
+
+          case Stage::kChecks:
+            if (quiet_index_ < quiets_.Size()) {
+                return quiets_.Move(quiet_index_++);
+            }
+
+            stage_ = Stage::kDone;
+            break;
+
+          case Stage::kGenerateEvasions:
+            quiets_.Resize(GenerateCheckEvasions<P>(*position_,
+                                                    quiets_.Data()));
+
+            for (std::size_t i = 0; i < quiets_.Size(); i++) {
+                const std::uint32_t move = quiets_.Move(i);
+
+                if (move == hash_move_) {
+                    quiets_.Score(i) = kHashMoveScore;
+                } else if (IsCapture(move)) {
+                    quiets_.Score(i) = kCaptureScore + CaptureScore(move);
+                } else {
+                    quiets_.Score(i) = QuietScore(move);
+                }
+            }
+
+            stage_ = Stage::kEvasions;
+            break;
+
+          case Stage::kEvasions:
+            if (quiet_index_ < quiets_.Size()) {
+                return quiets_.PickBest(quiet_index_++);
+            }
+
+            stage_ = Stage::kDone;
+            break;
+
+          default:
+            return kNullMove;
+        }
+    }
+}
+
+/**
+ * @brief Get the current stage
+ *
+ * @return The stage the next move will come from
+ */
+template <Player P>
+auto MovePicker<P>::GetStage() const noexcept -> Stage {
+    return stage_;
+}
+
+/**
+ * @brief Compute the MVV/LVA score of a capture or promotion
+ *
+ * @param move The move to score
+ *
+ * @return The ordering score. Higher is searched first
+ */
+template <Player P>
+std::int32_t MovePicker<P>::CaptureScore(std::uint32_t move) noexcept {
+    return 16 * (data_tables::kPieceValue[util::ExtractCaptured(move)] +
+                 data_tables::kPieceValue[util::ExtractPromoted(move)]) -
+        data_tables::kPieceValue[util::ExtractMoved(move)];
+}
+
+/**
+ * @brief Check whether a move is a capture or promotion
+ *
+ * @param move The move to check
+ *
+ * @return True if \a move captures or promotes
+ */
+template <Player P>
+bool MovePicker<P>::IsCapture(std::uint32_t move) noexcept {
+    return util::ExtractCaptured(move) != Piece::EMPTY ||
+           util::ExtractPromoted(move) != Piece::EMPTY;
+}
+
+/**
+ * @brief Check whether a capture keeps at least its material gain once the
+ *        opponent recaptures. A capture of an equal or more valuable piece
+ *        always does, so static exchange evaluation only runs for the rest
+ *
+ * @param move The capture to check
+ *
+ * @return True if \a move does not lose material
+ */
+template <Player P>
+bool MovePicker<P>::IsGoodCapture(std::uint32_t move) noexcept {
+    const Piece promoted = util::ExtractPromoted(move);
+
+    const int gain =
+        data_tables::kPieceValue[util::ExtractCaptured(move)] +
+        (promoted == Piece::EMPTY ? 0 :
+            data_tables::kPieceValue[promoted] - kPawnValue);
+
+    if (data_tables::kPieceValue[util::ExtractMoved(move)] <= gain) {
+        return true;
+    }
+
+    Position::UndoInfo undo;
+    position_->MakeMove<P>(move, &undo);
+
+    const bool good = gain >=
+        ComputeSee<util::opponent<P>()>(*position_, util::ExtractTo(move));
+
+    position_->UnMakeMove<P>(move, undo);
+
+    return good;
+}
+
+/**
+ * @brief Compute the ordering score of a quiet move
+ *
+ * @param move The move to score
+ *
+ * @return The ordering score. Higher is searched first
+ */
+template <Player P>
+std::int32_t MovePicker<P>::QuietScore(std::uint32_t move) const noexcept {
+    if (move == killers_[0]) return kKillerScore;
+    if (move == killers_[1]) return kKillerScore - 1;
+
+    return history_[util::ExtractFrom(move)][util::ExtractTo(move)];
+}
+
+}  // namespace chess
+
+#endif  // CHESS_MOVE_PICKER_H_
@@ -68,6 +68,104 @@ constexpr bool SafeForKing(const Position& pos, Square square) noexcept {
     return true;
 }
 
+/**
+ * Get the pawns which may advance without exposing the king, i.e. those not
+ * pinned or pinned along the king's file
+ *
+ * @tparam P The player whose pawns to get
+ *
+ * @param[in] pos    The current position
+ * @param[in] pinned The set of pieces pinned on the king
+ *
+ * @return The pawns which may advance
+ */
+template <Player P>
+constexpr std::uint64_t AdvanceablePawns(const Position& pos,
+                                         std::uint64_t pinned) noexcept {
+    const auto& info = pos.GetPlayerInfo<P>();
+
+    return info.Pawns() &
+        (~pinned | data_tables::kFiles64[info.KingSquare()]);
+}
+
+/**
+ * Get the pieces which would give discovered check by leaving the line
+ * between one of their own sliders and the enemy king
+ *
+ * @tparam P The player giving check
+ *
+ * @param[in] pos The current position
+ *
+ * @return The set of pieces that may give discovered check
+ */
+template <Player P>
+constexpr std::uint64_t DiscoveredCheckers(const Position& pos) noexcept {
+    const std::uint64_t occupied = pos.Occupied();
+
+    const auto& info = pos.GetPlayerInfo<P>();
+
+    const Square king_square =
+        pos.GetPlayerInfo<util::opponent<P>()>().KingSquare();
+
+    const std::uint64_t rooks_queens   = info.Rooks()   | info.Queens();
+    const std::uint64_t bishops_queens = info.Bishops() | info.Queens();
+
+    std::uint64_t candidates =
+        AttacksFrom<Piece::QUEEN>(king_square, occupied) & info.Occupied();
+    std::uint64_t checkers = 0;
+
+    while (candidates) {
+        const auto from = static_cast<Square>(util::Msb(candidates));
+
+        candidates &= data_tables::kClearMask[from];
+
+        // The ray from the king ends on this piece, so a slider on the far
+        // side of it is the only thing that can see the king once it moves
+
+        std::uint64_t sliders = 0;
+
+        switch (data_tables::kDirections[from][king_square]) {
+          case Direction::kAlongRank:
+            sliders = AttacksFrom<Piece::ROOK>(from, occupied) &
+                data_tables::kRanks64[from] & rooks_queens;
+            break;
+          case Direction::kAlongFile:
+            sliders = AttacksFrom<Piece::ROOK>(from, occupied) &
+                data_tables::kFiles64[from] & rooks_queens;
+            break;
+          case Direction::kAlongA1H8:
+            sliders = AttacksFrom<Piece::BISHOP>(from, occupied) &
+                data_tables::kA1H8_64[from] & bishops_queens;
+            break;
+          case Direction::kAlongH1A8:
+            sliders = AttacksFrom<Piece::BISHOP>(from, occupied) &
+                data_tables::kH1A8_64[from] & bishops_queens;
+            break;
+          default:
+            break;
+        }
+
+        if (sliders) checkers |= data_tables::kSetMask[from];
+    }
+
+    return checkers;
+}
+
+/**
+ * Check whether moving a piece takes it off the line connecting its origin
+ * to a king
+ *
+ * @param[in] king The king square
+ * @param[in] from The origin square, which lies on a line with \a king
+ * @param[in] to   The destination square
+ *
+ * @return True if \a to is not on the line through \a king and \a from
+ */
+constexpr bool LeavesLine(Square king, Square from, Square to) noexcept {
+    return data_tables::kDirections[king][to] !=
+           data_tables::kDirections[king][from];
+}
+
 }  // namespace detail
 
 /**
@@ -89,15 +187,13 @@ std::size_t GeneratePawnAdvances(const Position& pos,
                                  std::uint64_t target,
                                  std::uint64_t pinned,
                                  std::uint32_t* moves) noexcept {
-    const auto& info = pos.GetPlayerInfo<P>();
-    const Square king_square = info.KingSquare();
+    const std::uint64_t pawns = detail::AdvanceablePawns<P>(pos, pinned);
 
     const std::uint64_t vacant = ~pos.Occupied();
 
     constexpr std::uint64_t k3rdRank = data_tables::k3rdRank<P>;
 
-    std::uint64_t advances1 =
-        util::AdvancePawns1<P>(info.Pawns()) & vacant;
+    std::uint64_t advances1 = util::AdvancePawns1<P>(pawns) & vacant;
     std::uint64_t advances2 =
         util::AdvancePawns1<P>(advances1 & k3rdRank) & vacant & target;
 
@@ -111,24 +207,14 @@ std::size_t GeneratePawnAdvances(const Position& pos,
 
         const auto from = static_cast<int>(data_tables::kMinus8<P>[to]);
 
-        const bool immovable =
-            (pinned & data_tables::kSetMask[from]) &&
-                data_tables::kDirections[king_square][from] !=
-                    Direction::kAlongFile;
-
-        if (!immovable) {
-            if ((data_tables::kSetMask[to] & (kRank1 | kRank8)) == 0u) {
+        if ((data_tables::kSetMask[to] & (kRank1 | kRank8)) == 0u) {
+            moves[n_moves++] = util::PackMove(
+                Piece::EMPTY, from, Piece::PAWN, Piece::EMPTY, to);
+        } else {
+            for (auto promoted : detail::kPromotions) {
                 moves[n_moves++] = util::PackMove(
-                    Piece::EMPTY, from, Piece::PAWN, Piece::EMPTY, to);
-            } else {
-                for (auto promoted : detail::kPromotions) {
-                    moves[n_moves++] = util::PackMove(
-                        Piece::EMPTY, from, Piece::PAWN, promoted, to);
-                }
+                    Piece::EMPTY, from, Piece::PAWN, promoted, to);
             }
-        } else if ((data_tables::k3rdRank<P> & data_tables::kSetMask[to])) {
-            advances2 &=
-                data_tables::kClearMask[data_tables::kPlus8<P>[to]];
         }
 
         advances1 &= data_tables::kClearMask[to];
@@ -277,6 +363,10 @@ std::size_t GeneratePawnCaptures(const Position& pos,
 
     for (std::size_t i = 0; i <= 1 && attackers != 0u; i++) {
         const Square from = origins[i];
+
+        // Target on the edge of the board; only one possible origin
+        if (from == Square::Underflow) continue;
+
         const std::uint64_t from_mask = data_tables::kSetMask[from];
         if (attackers & from_mask) {
             if ((pinned & from_mask) == 0u ||
@@ -680,10 +770,217 @@ std::size_t GenerateCheckEvasions(
     return n_moves;
 }
 
+namespace detail {
+/**
+ * @brief Generate the non-captures of one piece type which give check
+ *
+ * @tparam P The player to generate moves for
+ * @tparam X The piece type: knight, bishop, rook or queen
+ *
+ * @param[in] pos         The position from which to generate moves
+ * @param[in] direct      Squares from which \a X attacks the enemy king
+ * @param[in] discoverers Pieces which give discovered check by moving
+ * @param[in] pinned      The set of pieces pinned on our king
+ * @param[out] moves      The set of legal moves
+ *
+ * @return The number of moves generated
+ */
+template <Player P, Piece X>
+std::size_t GeneratePieceChecks(const Position& pos,
+                                std::uint64_t direct,
+                                std::uint64_t discoverers,
+                                std::uint64_t pinned,
+                                std::uint32_t* moves) noexcept {
+    const std::uint64_t occupied = pos.Occupied();
+
+    const auto& info = pos.GetPlayerInfo<P>();
+
+    const Square king_square = info.KingSquare();
+    const Square enemy_king =
+        pos.GetPlayerInfo<util::opponent<P>()>().KingSquare();
+
+    std::uint64_t pieces;
+
+    if constexpr (X == Piece::KNIGHT) {
+        pieces = info.Knights() & ~pinned;
+    } else if constexpr (X == Piece::BISHOP) {
+        pieces = info.Bishops();
+    } else if constexpr (X == Piece::ROOK) {
+        pieces = info.Rooks();
+    } else {
+        pieces = info.Queens();
+    }
+
+    std::size_t n_moves = 0;
+
+    while (pieces) {
+        const auto from = static_cast<Square>(util::Msb(pieces));
+
+        pieces &= data_tables::kClearMask[from];
+
+        const std::uint64_t source = data_tables::kSetMask[from];
+
+        std::uint64_t attacks;
+
+        if constexpr (X == Piece::KNIGHT) {
+            attacks = data_tables::kKnightAttacks[from] & ~occupied;
+        } else {
+            attacks = AttacksFrom<X>(from, occupied) & ~occupied;
+        }
+
+        const bool discovers = (discoverers & source) != 0u;
+
+        if (!discovers) attacks &= direct;
+
+        while (attacks) {
+            const auto to = static_cast<Square>(util::Msb(attacks));
+
+            attacks &= data_tables::kClearMask[to];
+
+            // A pinned piece must stay on the line of the pin, and a
+            // discovered check requires leaving the line to the enemy king
+
+            if ((source & pinned) && LeavesLine(king_square, from, to)) {
+                continue;
+            }
+
+            if ((direct & data_tables::kSetMask[to]) == 0u &&
+                !LeavesLine(enemy_king, from, to)) {
+                continue;
+            }
+
+            moves[n_moves++] =
+                util::PackMove(Piece::EMPTY, from, X, Piece::EMPTY, to);
+        }
+    }
+
+    return n_moves;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Generate quiet moves which give check, either directly or by
+ *        uncovering an attack from a slider
+ *
+ * @note Assumes player is NOT in check. Promotions are left to
+ *       GenerateCaptures()
+ *
+ * @tparam P The player to generate moves for
+ *
+ * @param[in] pos     The position from which to generate moves
+ * @param[in] pinned  The set of pieces pinned on the king
+ * @param[out] moves  The set of legal moves
+ *
+ * @return The number of moves generated
+ */
 template <Player P>
-void GenerateChecks(const Position& pos,
-                    std::uint64_t pinned,
-                    std::array<std::uint32_t, 256>* moves) noexcept;
+std::size_t GenerateChecks(const Position& pos,
+                           std::uint64_t pinned,
+                           std::uint32_t* moves) noexcept {
+    constexpr Player O = util::opponent<P>();
+
+    const std::uint64_t occupied = pos.Occupied();
+
+    const auto& info = pos.GetPlayerInfo<P>();
+
+    const Square enemy_king = pos.GetPlayerInfo<O>().KingSquare();
+
+    const std::uint64_t discoverers = detail::DiscoveredCheckers<P>(pos);
+
+    // The squares from which each piece type attacks the enemy king
+
+    const std::uint64_t bishop_checks =
+        AttacksFrom<Piece::BISHOP>(enemy_king, occupied);
+    const std::uint64_t rook_checks =
+        AttacksFrom<Piece::ROOK>(enemy_king, occupied);
+
+    std::size_t n_moves = detail::GeneratePieceChecks<P, Piece::KNIGHT>(
+        pos, data_tables::kKnightAttacks[enemy_king], discoverers, pinned,
+        moves);
+
+    n_moves += detail::GeneratePieceChecks<P, Piece::BISHOP>(
+        pos, bishop_checks, discoverers, pinned, &moves[n_moves]);
+
+    n_moves += detail::GeneratePieceChecks<P, Piece::ROOK>(
+        pos, rook_checks, discoverers, pinned, &moves[n_moves]);
+
+    n_moves += detail::GeneratePieceChecks<P, Piece::QUEEN>(
+        pos, bishop_checks | rook_checks, discoverers, pinned,
+        &moves[n_moves]);
+
+    // Pawn advances are filtered after the fact, since each one is cheap
+    // to test
+
+    const std::uint64_t pawn_checks = data_tables::kPawnAttacks<O>[enemy_king];
+
+    std::size_t n_pawn_moves = GeneratePawnAdvances<P>(
+        pos, ~data_tables::kBackRank<O>, pinned, &moves[n_moves]);
+
+    for (std::size_t i = n_moves; i < n_moves + n_pawn_moves; ) {
+        const Square from = util::ExtractFrom(moves[i]);
+        const Square to   = util::ExtractTo(moves[i]);
+
+        if ((pawn_checks & data_tables::kSetMask[to]) ||
+            ((discoverers & data_tables::kSetMask[from]) &&
+             detail::LeavesLine(enemy_king, from, to))) {
+            i++;
+        } else {
+            moves[i] = moves[n_moves + --n_pawn_moves];
+        }
+    }
+
+    n_moves += n_pawn_moves;
+
+    // The king can only give discovered check, except that castling may
+    // give check with the rook
+
+    std::uint32_t king_moves[10];
+
+    std::size_t n_king_moves = 0;
+
+    if (info.King() & discoverers) {
+        n_king_moves = GenerateKingMoves<P>(pos, ~occupied, king_moves);
+    }
+
+    n_king_moves += GenerateCastleMoves<P>(pos, &king_moves[n_king_moves]);
+
+    const Square king_home = data_tables::kKingHome<P>;
+
+    for (std::size_t i = 0; i < n_king_moves; i++) {
+        const std::uint32_t move = king_moves[i];
+
+        const Square from = util::ExtractFrom(move);
+        const Square to   = util::ExtractTo(move);
+
+        bool check = (discoverers & data_tables::kSetMask[from]) &&
+                     detail::LeavesLine(enemy_king, from, to);
+
+        if (from == king_home &&
+            (to == data_tables::kCastleShortDest<P> ||
+             to == data_tables::kCastleLongDest<P>)) {
+            const bool is_short = to == data_tables::kCastleShortDest<P>;
+
+            const Square rook_from = is_short ? data_tables::kRookHomeH<P> :
+                                                data_tables::kRookHomeA<P>;
+            const Square rook_to = is_short ?
+                data_tables::kCastleShortPath<P>[0] :
+                data_tables::kCastleLongPath<P>[0];
+
+            const std::uint64_t after = occupied ^
+                data_tables::kSetMask[from] ^ data_tables::kSetMask[to] ^
+                data_tables::kSetMask[rook_from] ^
+                data_tables::kSetMask[rook_to];
+
+            check = check || (AttacksFrom<Piece::ROOK>(rook_to, after) &
+                              data_tables::kSetMask[enemy_king]) != 0u;
+        }
+
+        if (check) moves[n_moves++] = move;
+    }
+
+    return n_moves;
+}
 
 /**
  * @brief Generate quiet moves
@@ -746,8 +1043,526 @@ std::size_t GenerateLegalMoves(const Position& pos,
     return n_moves;
 }
 
+namespace detail {
+/**
+ * @brief Count the legal knight, rook, bishop and queen moves. This mirrors
+ *        GenerateMoves() but counts target bits instead of packing moves
+ *
+ * @tparam P   The player to count moves for
+ * @tparam Any If true, return as soon as any move is found
+ *
+ * @param[in] pos     The current position
+ * @param[in] target  The target squares to move to
+ * @param[in] pinned  The set of pieces pinned on the king
+ *
+ * @return The number of moves
+ */
+template <Player P, bool Any>
+std::size_t CountMoves(const Position& pos,
+                       std::uint64_t target,
+                       std::uint64_t pinned) noexcept {
+    const std::uint64_t occupied = pos.Occupied();
+
+    const auto& info = pos.GetPlayerInfo<P>();
+
+    const Square king_square = info.KingSquare();
+
+    std::size_t n_moves = 0;
+
+    for (std::uint64_t knights = info.Knights() & (~pinned); knights; ) {
+        const std::int8_t from = util::Msb(knights);
+
+        n_moves += util::BitCount(data_tables::kKnightAttacks[from] & target);
+        if (Any && n_moves) return n_moves;
+
+        knights &= data_tables::kClearMask[from];
+    }
+
+    // A pinned slider may only move along the line of the pin, which for
+    // the wrong kind of slider leaves no moves at all
+
+    for (std::uint64_t sliders = info.Rooks() | info.Bishops() | info.Queens();
+         sliders; ) {
+        const auto from = static_cast<Square>(util::Msb(sliders));
+        const std::uint64_t from_mask = data_tables::kSetMask[from];
+
+        std::uint64_t attacks = 0;
+
+        if (from_mask & (info.Rooks() | info.Queens())) {
+            attacks |= AttacksFrom<Piece::ROOK>(from, occupied);
+        }
+
+        if (from_mask & (info.Bishops() | info.Queens())) {
+            attacks |= AttacksFrom<Piece::BISHOP>(from, occupied);
+        }
+
+        if (from_mask & pinned) {
+            switch (data_tables::kDirections[from][king_square]) {
+              case Direction::kAlongRank:
+                attacks &= data_tables::kRanks64[from];
+                break;
+              case Direction::kAlongFile:
+                attacks &= data_tables::kFiles64[from];
+                break;
+              case Direction::kAlongA1H8:
+                attacks &= data_tables::kA1H8_64[from];
+                break;
+              default:
+                attacks &= data_tables::kH1A8_64[from];
+            }
+        }
+
+        n_moves += util::BitCount(attacks & target);
+        if (Any && n_moves) return n_moves;
+
+        sliders &= data_tables::kClearMask[from];
+    }
+
+    return n_moves;
+}
+
+/**
+ * @brief Count the legal king moves. This mirrors GenerateKingMoves()
+ *
+ * @tparam P   The player to count moves for
+ * @tparam Any If true, return as soon as any move is found
+ *
+ * @param[in] pos     The current position
+ * @param[in] target  The target squares to move to
+ *
+ * @return The number of moves
+ */
+template <Player P, bool Any>
+std::size_t CountKingMoves(const Position& pos,
+                           std::uint64_t target) noexcept {
+    const Square king_square = pos.GetPlayerInfo<P>().KingSquare();
+
+    std::size_t n_moves = 0;
+
+    std::uint64_t attacks = data_tables::kKingAttacks[king_square] & target;
+    while (attacks) {
+        const auto to = static_cast<Square>(util::Msb(attacks));
+
+        if (SafeForKing<P>(pos, to)) {
+            n_moves++;
+            if (Any) return n_moves;
+        }
+
+        attacks &= data_tables::kClearMask[to];
+    }
+
+    return n_moves;
+}
+
+/**
+ * @brief Count the legal pawn advances. This mirrors GeneratePawnAdvances()
+ *
+ * @tparam P The player to count moves for
+ *
+ * @param[in] pos     The current position
+ * @param[in] target  Limit moves to these squares
+ * @param[in] pinned  The set of pieces pinned on the king
+ *
+ * @return The number of moves, counting each promotion piece separately
+ */
+template <Player P>
+std::size_t CountPawnAdvances(const Position& pos,
+                              std::uint64_t target,
+                              std::uint64_t pinned) noexcept {
+    const std::uint64_t vacant = ~pos.Occupied();
+
+    const std::uint64_t advances1 =
+        util::AdvancePawns1<P>(AdvanceablePawns<P>(pos, pinned)) & vacant;
+    const std::uint64_t advances2 =
+        util::AdvancePawns1<P>(advances1 & data_tables::k3rdRank<P>) &
+            vacant & target;
+
+    return util::BitCount(advances1 & target & ~(kRank1 | kRank8)) +
+           util::BitCount(advances1 & target &  (kRank1 | kRank8)) *
+                kPromotions.size() +
+           util::BitCount(advances2);
+}
+
+/**
+ * @brief Count the legal pawn captures and promotions. This mirrors
+ *        GeneratePawnCaptures()
+ *
+ * @tparam P The player to count moves for
+ *
+ * @param[in] pos     The current position
+ * @param[in] target  Limit moves to these squares
+ * @param[in] pinned  The set of pieces pinned on the king
+ *
+ * @return The number of moves, counting each promotion piece separately
+ */
+template <Player P>
+std::size_t CountPawnCaptures(const Position& pos,
+                              std::uint64_t target,
+                              std::uint64_t pinned) noexcept {
+    constexpr std::uint64_t kBackRanks = kRank1 | kRank8;
+
+    const auto& info = pos.GetPlayerInfo<P>();
+    const auto& opponent = pos.GetPlayerInfo<util::opponent<P>()>();
+
+    const std::uint64_t free_pawns = info.Pawns() & (~pinned);
+    const std::uint64_t victims = target & opponent.Occupied();
+
+    // A square may be captured by two pawns, so count each side apart
+
+    const std::uint64_t right = util::ShiftPawnsR<P>(free_pawns) & victims;
+    const std::uint64_t left  = util::ShiftPawnsL<P>(free_pawns) & victims;
+
+    std::size_t n_moves =
+        util::BitCount(right & ~kBackRanks) +
+        util::BitCount(left  & ~kBackRanks) +
+        (util::BitCount(right & kBackRanks) +
+         util::BitCount(left  & kBackRanks)) * kPromotions.size();
+
+    // Pinned pawns are rare enough to check one at a time
+
+    const Square king_square = info.KingSquare();
+
+    for (std::uint64_t pawns = info.Pawns() & pinned; pawns; ) {
+        const auto from = static_cast<Square>(util::Msb(pawns));
+        const std::uint64_t from_mask = data_tables::kSetMask[from];
+
+        const std::uint64_t to_r = util::ShiftPawnsR<P>(from_mask) & victims;
+        const std::uint64_t to_l = util::ShiftPawnsL<P>(from_mask) & victims;
+
+        if (to_r && data_tables::kDirections[king_square][util::Msb(to_r)]
+                == Direction::kAlongA1H8) {
+            n_moves += (to_r & kBackRanks) ? kPromotions.size() : 1;
+        }
+
+        if (to_l && data_tables::kDirections[king_square][util::Msb(to_l)]
+                == Direction::kAlongH1A8) {
+            n_moves += (to_l & kBackRanks) ? kPromotions.size() : 1;
+        }
+
+        pawns &= data_tables::kClearMask[from];
+    }
+
+    // Promotions via pawn pushes
+
+    const std::uint64_t advances1 =
+        util::AdvancePawns1<P>(free_pawns) &
+            data_tables::kBackRank<util::opponent<P>()> &
+            ~pos.Occupied() & target;
+
+    n_moves += util::BitCount(advances1) * kPromotions.size();
+
+    // En passant captures are rare, and legal only after a careful check
+    // for discovered attacks, so generate them
+
+    const std::uint64_t ep_target = pos.EnPassantTargetMask() & target;
+
+    if (data_tables::k3rdRank<util::opponent<P>()> & ep_target) {
+        std::uint32_t moves[kMaxMoves];
+        n_moves += GeneratePawnCaptures<P>(pos, ep_target, pinned, moves);
+    }
+
+    return n_moves;
+}
+
+/**
+ * @brief Count the legal moves, whether or not in check
+ *
+ * @tparam P   The player to count moves for
+ * @tparam Any If true, return as soon as any move is found
+ *
+ * @param[in] pos The current position
+ *
+ * @return The number of moves
+ */
+template <Player P, bool Any>
+std::size_t CountLegalMoves(const Position& pos) noexcept {
+    const auto& info = pos.GetPlayerInfo<P>();
+    const auto& opponent = pos.GetPlayerInfo<util::opponent<P>()>();
+
+    const std::uint64_t occupied = pos.Occupied();
+    const std::uint64_t pinned = pos.PinnedPieces<P>();
+
+    const Square king_square = info.KingSquare();
+
+    const std::uint64_t attackers =
+        opponent.AttacksTo(king_square, occupied);
+
+    std::size_t n_moves = CountKingMoves<P, Any>(pos, ~info.Occupied());
+    if (Any && n_moves) return n_moves;
+
+    if (attackers == 0u) {
+        n_moves += CountMoves<P, Any>(pos, ~info.Occupied(), pinned);
+        if (Any && n_moves) return n_moves;
+
+        constexpr std::uint64_t kBackRank =
+            data_tables::kBackRank<util::opponent<P>()>;
+
+        n_moves += CountPawnAdvances<P>(pos, ~occupied & ~kBackRank, pinned);
+        n_moves += CountPawnCaptures<P>(
+            pos, opponent.Occupied() | kBackRank | pos.EnPassantTargetMask(),
+            pinned);
+
+        if (info.CanCastleLong() || info.CanCastleShort()) {
+            std::uint32_t moves[2];
+            n_moves += GenerateCastleMoves<P>(pos, moves);
+        }
+
+        return n_moves;
+    }
+
+    // Only the king can get out of a double check
+
+    if (attackers & (attackers-1)) return n_moves;
+
+    const std::int8_t attacker = util::Msb(attackers);
+    const std::uint64_t target =
+        data_tables::kRaySegment[king_square][attacker];
+
+    n_moves += CountMoves<P, Any>(pos, target | attackers, pinned);
+    if (Any && n_moves) return n_moves;
+
+    n_moves += CountPawnAdvances<P>(pos, target, pinned);
+
+    const std::uint64_t pawn_target =
+        (data_tables::kMinus8<util::opponent<P>()>[attacker] ==
+            pos.EnPassantTarget()) ?
+                (attackers | pos.EnPassantTargetMask()) : attackers;
+
+    return n_moves + CountPawnCaptures<P>(pos, pawn_target, pinned);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Count the legal moves without generating them. Unlike
+ *        GenerateLegalMoves(), this may be called while in check
+ *
+ * @tparam P The player to count moves for
+ *
+ * @param[in] pos The position to count moves from
+ *
+ * @return The number of legal moves
+ */
+template <Player P> inline
+std::size_t CountLegalMoves(const Position& pos) noexcept {
+    return detail::CountLegalMoves<P, false>(pos);
+}
+
+/**
+ * @brief Check whether there is any legal move, stopping at the first one
+ *        found. May be called while in check
+ *
+ * @tparam P The player to check for moves
+ *
+ * @param[in] pos The position to check
+ *
+ * @return True if \a P has at least one legal move
+ */
+template <Player P> inline
+bool HasAnyLegalMove(const Position& pos) noexcept {
+    return detail::CountLegalMoves<P, true>(pos) > 0u;
+}
+
+/**
+ * @brief Check whether a move is legal in a position, without generating
+ *        any moves. Meant for moves from elsewhere that may not apply here,
+ *        such as hash and killer moves
+ *
+ * @tparam P The player to move
+ *
+ * @param[in] pos   The current position
+ * @param[in] move  The move to check
+ *
+ * @return True if \a move is legal
+ */
 template <Player P>
-bool ValidateMove(const Position& pos, std::uint32_t move) noexcept;
+bool ValidateMove(const Position& pos, std::uint32_t move) noexcept {
+    constexpr Player O = util::opponent<P>();
+
+    const auto& info = pos.GetPlayerInfo<P>();
+    const auto& opponent = pos.GetPlayerInfo<O>();
+
+    const Square from    = util::ExtractFrom(move);
+    const Square to      = util::ExtractTo(move);
+    const Piece moved    = util::ExtractMoved(move);
+    const Piece captured = util::ExtractCaptured(move);
+    const Piece promoted = util::ExtractPromoted(move);
+
+    const std::uint64_t from_mask = data_tables::kSetMask[from];
+    const std::uint64_t to_mask   = data_tables::kSetMask[to];
+    const std::uint64_t occupied  = pos.Occupied();
+
+    /*
+     * Step 1: The piece must be ours and on its origin square
+     */
+    if ((info.Occupied() & from_mask) == 0u || pos.PieceOn(from) != moved) {
+        return false;
+    }
+
+    /*
+     * Step 2: The destination must hold the captured piece, except for en
+     *         passant captures which land on an empty square
+     */
+    const bool en_passant = moved == Piece::PAWN &&
+        captured == Piece::PAWN &&
+        (to_mask & pos.EnPassantTargetMask() &
+            data_tables::k3rdRank<O>) != 0u;
+
+    if (en_passant) {
+        // The target square is always empty
+    } else if (captured == Piece::EMPTY) {
+        if (occupied & to_mask) return false;
+    } else if (captured == Piece::KING ||
+               (opponent.Occupied() & to_mask) == 0u ||
+               pos.PieceOn(to) != captured) {
+        return false;
+    }
+
+    /*
+     * Step 3: Pawns reaching the back rank must promote, and nothing else
+     *         may
+     */
+    if (moved == Piece::PAWN && (to_mask & data_tables::kBackRank<O>)) {
+        if (promoted == Piece::PAWN || promoted >= Piece::KING) return false;
+    } else if (promoted != Piece::EMPTY) {
+        return false;
+    }
+
+    const Square king_square = info.KingSquare();
+
+    /*
+     * Step 4: King moves, including castling, only need the destination
+     *         to be safe
+     */
+    if (moved == Piece::KING) {
+        if (data_tables::kKingAttacks[from] & to_mask) {
+            return detail::SafeForKing<P>(pos, to);
+        }
+
+        if (from != data_tables::kKingHome<P> || captured != Piece::EMPTY ||
+            pos.InCheck<P>()) {
+            return false;
+        }
+
+        if (to == data_tables::kCastleShortDest<P>) {
+            return info.CanCastleShort() &&
+                (occupied & data_tables::kCastleShortClearance<P>) == 0u &&
+                !pos.UnderAttack<O>(data_tables::kCastleShortPath<P>[0]) &&
+                !pos.UnderAttack<O>(data_tables::kCastleShortPath<P>[1]);
+        }
+
+        if (to == data_tables::kCastleLongDest<P>) {
+            return info.CanCastleLong() &&
+                (occupied & data_tables::kCastleLongClearance<P>) == 0u &&
+                !pos.UnderAttack<O>(data_tables::kCastleLongPath<P>[0]) &&
+                !pos.UnderAttack<O>(data_tables::kCastleLongPath<P>[1]);
+        }
+
+        return false;
+    }
+
+    /*
+     * Step 5: The piece must be able to reach the destination
+     */
+    const Direction direction = data_tables::kDirections[from][to];
+
+    const bool clear_path =
+        (data_tables::kRaySegment[from][to] & occupied) == 0u;
+
+    switch (moved) {
+      case Piece::PAWN:
+        if (captured != Piece::EMPTY) {
+            if ((data_tables::kPawnAttacks<P>[from] & to_mask) == 0u) {
+                return false;
+            }
+        } else if (to != data_tables::kPlus8<P>[from]) {
+            // A double advance needs the square in between to be empty
+
+            const Square middle = data_tables::kPlus8<P>[from];
+
+            if (to != data_tables::kPlus16<P>[from] ||
+                (data_tables::kSetMask[middle] & data_tables::k3rdRank<P> &
+                    ~occupied) == 0u) {
+                return false;
+            }
+        }
+        break;
+      case Piece::KNIGHT:
+        if ((data_tables::kKnightAttacks[from] & to_mask) == 0u) {
+            return false;
+        }
+        break;
+      case Piece::BISHOP:
+        if ((direction != Direction::kAlongA1H8 &&
+             direction != Direction::kAlongH1A8) || !clear_path) {
+            return false;
+        }
+        break;
+      case Piece::ROOK:
+        if ((direction != Direction::kAlongRank &&
+             direction != Direction::kAlongFile) || !clear_path) {
+            return false;
+        }
+        break;
+      case Piece::QUEEN:
+        if (direction == Direction::kNone || !clear_path) return false;
+        break;
+      default:
+        return false;
+    }
+
+    /*
+     * Step 6: The move must not expose our king. A pinned piece must stay
+     *         on the line of the pin
+     */
+    if ((pos.PinnedPieces<P>() & from_mask) &&
+        detail::LeavesLine(king_square, from, to)) {
+        return false;
+    }
+
+    const Square victim = en_passant ? data_tables::kMinus8<P>[to] : to;
+
+    /*
+     * Step 7: If in check, the move must capture the checking piece or
+     *         block its attack. Two checkers leave only king moves
+     */
+    if (pos.InCheck<P>()) {
+        const std::uint64_t checkers =
+            opponent.AttacksTo(king_square, occupied);
+
+        if (checkers & (checkers-1)) return false;
+
+        const auto checker = static_cast<Square>(util::Msb(checkers));
+
+        const std::uint64_t target =
+            data_tables::kRaySegment[king_square][checker] | checkers;
+
+        if ((target & (to_mask | data_tables::kSetMask[victim])) == 0u) {
+            return false;
+        }
+    }
+
+    /*
+     * Step 8: An en passant capture removes two pieces from the board,
+     *         which may expose the king along a rank
+     */
+    if (en_passant) {
+        const std::uint64_t after =
+            (occupied ^ from_mask ^ data_tables::kSetMask[victim]) | to_mask;
+
+        if (AttacksFrom<Piece::ROOK>(king_square, after) &
+                (opponent.Rooks() | opponent.Queens())) {
+            return false;
+        }
+
+        if (AttacksFrom<Piece::BISHOP>(king_square, after) &
+                (opponent.Bishops() | opponent.Queens())) {
+            return false;
+        }
+    }
+
+    return true;
+}
 
 }  // namespace chess
 
@@ -9,15 +9,18 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cmath>
 #include <cstdint>
 #include <cstddef>
-#include <iterator>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "chess/chess.h"
 #include "chess/evaluate.h"
+#include "chess/game_history.h"
 #include "chess/logger.h"
 #include "chess/memory_pool.h"
 #include "chess/movegen.h"
@@ -30,27 +33,68 @@ std::size_t random(std::size_t max_value);
 
 /**
  * @brief Monte Carlo Tree Search
+ *
+ * Supports tree parallelism: several threads descend the same tree at once.
+ * Each thread applies a virtual loss to the nodes along its path so that
+ * other threads are steered toward different lines
  */
 class Mtcs final : public Search {
 public:
+    /**
+     * The score added to a node while a thread is still searching beneath
+     * it, making the node look worse to the player choosing it
+     */
+    static constexpr int kVirtualLoss = 1;
+
+    /**
+     * The number of iterations run per call to Run(), unless changed by
+     * SetIterations()
+     */
+    static constexpr std::size_t kDefaultIterations = 2000;
+
+    /**
+     * The clock is read once per this many iterations
+     */
+    static constexpr std::size_t kTimeCheckInterval = 16;
+
+    /**
+     * Milliseconds between UCI "info" reports while searching
+     */
+    static constexpr std::int64_t kInfoInterval = 1000;
+
+    /**
+     * A playout cut off before the game ends is scored as a win for the
+     * player who leads the static evaluation by at least this many
+     * centipawns, and as a draw otherwise
+     */
+    static constexpr int kAdjudicationMargin = kKnightValue;
+
     /**
      * @brief Represents a single node in the game tree
+     *
+     * The children of a node are created together, the first time the node
+     * is stepped through, as one contiguous block allocated from the pool.
+     * Each child records the move leading to it next to its statistics, so
+     * selecting a child scans a single array without generating moves
      */
     class Node final {
     public:
         Node();
 
-        Node(const Node& node) = default;
-        Node(Node&& nodes) = default;
-        Node& operator=(const Node& node) = default;
-        Node& operator=(Node& node) = default;
+        Node(const Node& node) = delete;
+        Node(Node&& node) = delete;
+        Node& operator=(const Node& node) = delete;
+        Node& operator=(Node&& node) = delete;
 
         ~Node() = default;
 
         double Average() const;
 
+        std::uint32_t Move() const noexcept;
+
         template <Player P>
         int Select(Position* position,
+                   GameHistory* history,
                    MemoryPool<Node>* pool,
                    std::size_t ply,
                    std::uint32_t* predicted);
@@ -58,70 +102,131 @@ public:
         std::uint32_t Visits() const;
 
     private:
-        Node* End();
+        friend class Mtcs;
+
+        template <Player P>
+        int Descend(Position* position,
+                    GameHistory* history,
+                    MemoryPool<Node>* pool,
+                    std::size_t ply,
+                    std::uint32_t* predicted,
+                    std::uint32_t visits);
+
+        template <Player P>
+        bool Expand(const Position& position, MemoryPool<Node>* pool);
+
+        void Lock() noexcept;
+
+        void Unlock() noexcept;
+
+        // Members are ordered by size rather than by name so that a Node
+        // packs into 24 bytes
 
         /**
-         * Successor nodes from *this
+         * Successor nodes from *this, stored contiguously
          */
         Node* childs_;
 
         /**
-         * The hash signature of the position at this node
+         * The move leading to this node from its parent
          */
-        std::uint64_t hash_;
+        std::uint32_t move_;
 
         /**
-         * Next sibling node to *this
+         * The total sum of scores backpropagated to this node, from the
+         * perspective of the player to move at this node
          */
-        Node* next_;
+        std::atomic<std::int32_t> sum_;
 
         /**
-         * Number of successor nodes from *this
+         * The total number of visits to this node
          */
-        std::uint8_t num_childs_;
+        std::atomic<std::uint32_t> visits_;
 
         /**
-         * The total sum of scores backpropagated to this node
+         * Set once \ref childs_ and \ref num_childs_ are valid
          */
-        std::int32_t sum_;
+        std::atomic<bool> expanded_;
 
         /**
-         * The total number of visits to this node
+         * Held while this node is being expanded
+         */
+        std::atomic<bool> locked_;
+
+        /**
+         * Number of successor nodes from *this
          */
-        std::uint32_t visits_;
+        std::uint8_t num_childs_;
     };
 
     Mtcs(std::shared_ptr<MemoryPool<Node>> pool,
          std::shared_ptr<Logger> logger);
 
-    Mtcs(const Mtcs& algorithm) = default;
-    Mtcs(Mtcs&& algorithm) = default;
-    Mtcs& operator=(const Mtcs& algorithm) = default;
-    Mtcs& operator=(Mtcs& algorithm) = default;
+    Mtcs(const Mtcs& algorithm) = delete;
+    Mtcs(Mtcs&& algorithm) = delete;
+    Mtcs& operator=(const Mtcs& algorithm) = delete;
+    Mtcs& operator=(Mtcs&& algorithm) = delete;
 
     ~Mtcs() = default;
 
+    void Clear();
+
     template <Player P>
     static int ComputeWin(const Position& position);
 
+    std::size_t Iterations() const noexcept;
+
+    std::size_t RootVisits() const noexcept;
+
     std::uint32_t Run(const Position& position) override;
 
+    void SetIterations(std::size_t iterations) noexcept;
+
+    void SetThreads(std::size_t threads) noexcept;
+
     template <Player P>
-    static std::int32_t Simulate(Position* position, std::size_t ply);
+    static std::int32_t Simulate(Position* position, GameHistory* history,
+                                 std::size_t ply);
 
 private:
     template <Player P>
-    std::pair<double, std::uint32_t> SelectRoot(Position* position);
+    bool ExpandRoot();
+
+    SearchInfo Info(std::int64_t elapsed) const;
+
+    bool OutOfTime() const;
+
+    template <Player P>
+    static bool PlayRandomMove(Position* position,
+                               GameHistory* history,
+                               std::size_t ply,
+                               std::uint32_t* played,
+                               Position::UndoInfo* undo);
+
+    void Promote(Node* node);
+
+    void Release(Node* node, const Node* keep);
+
+    template <Player P>
+    bool Reuse(const Position& position);
+
+    template <Player P>
+    void SelectRoot(Position* position, GameHistory* history);
+
+    /**
+     * The number of iterations to run per call to Run()
+     */
+    std::size_t max_iterations_;
 
     /**
-     * Successor nodes from *this
+     * The number of threads to search with
      */
-    std::vector<std::shared_ptr<Node>> childs_;
+    std::size_t n_threads_;
 
     /**
-     * Number of iterations of this algorithm (i.e. calls to Run())
+     * Number of iterations completed during the current call to Run()
      */
-    std::size_t iterations_;
+    std::atomic<std::size_t> iterations_;
 
     /**
      * For logging errors/diagnostics
@@ -133,12 +238,36 @@ private:
      */
     std::shared_ptr<MemoryPool<Node>>
         node_pool_;
+
+    /**
+     * The position at the root of the tree
+     */
+    Position root_;
+
+    /**
+     * The root of the tree. Its children are all expanded before the search
+     * starts so that threads need not synchronize at the root
+     */
+    Node root_node_;
+
+    /**
+     * Total visits to the root, including those from earlier searches whose
+     * tree was reused
+     */
+    std::atomic<std::size_t> root_visits_;
+
+    /**
+     * The length of the longest line selected during the current call to
+     * Run(), in plies
+     */
+    std::atomic<std::size_t> seldepth_;
 };
 
 /**
  * @brief Select the next node to explore
  *
  * @param position  The current position at this node
+ * @param history   The positions leading to this node
  * @param pool      The memory pool to allocate new nodes from
  * @param ply       The depth at this node
  * @param predicted The predicted line of play
@@ -147,102 +276,172 @@ private:
  */
 template <Player P>
 int Mtcs::Node::Select(Position* position,
+                       GameHistory* history,
                        MemoryPool<Node>* pool,
                        std::size_t ply,
                        std::uint32_t* predicted) {
-    visits_++;
+    // Apply a virtual loss (from the perspective of the player who moved
+    // into this node) until the result of this visit is known
+
+    const std::uint32_t visits =
+        visits_.fetch_add(1, std::memory_order_relaxed) + 1;
+    sum_.fetch_add(kVirtualLoss, std::memory_order_relaxed);
 
-    // If this node has never been visited, simulate a playout
+    int result;
 
-    if (visits_ == 1u) {
-        const int result = Mtcs::Simulate<P>(position, ply);
+    // A drawn node is never expanded. If this node has never been visited,
+    // simulate a playout
 
-        sum_ += result;
+    if (history->IsDraw(*position, ply)) {
+        result = 0;
 
         predicted[ply] = kNullMove;
+    } else if (visits == 1u) {
+        result = Mtcs::Simulate<P>(position, history, ply);
 
-        return result;
+        predicted[ply] = kNullMove;
+    } else {
+        result = Descend<P>(position, history, pool, ply, predicted, visits);
     }
 
-    std::array<std::uint32_t, kMaxMoves> moves;
+    sum_.fetch_add(result - kVirtualLoss, std::memory_order_relaxed);
 
-    const std::size_t n_moves = position->InCheck<P>() ?
-            GenerateCheckEvasions<P>(*position, moves.data()) :
-            GenerateLegalMoves<P>(*position, moves.data());
+    return result;
+}
 
-    if (n_moves == 0u) {
+/**
+ * @brief Step into a child of this node, expanding all children first if
+ *        this is the first time through
+ *
+ * @param position  The current position at this node
+ * @param history   The positions leading to this node
+ * @param pool      The memory pool to allocate new nodes from
+ * @param ply       The depth at this node
+ * @param predicted The predicted line of play
+ * @param visits    The number of visits to this node, including this one
+ *
+ * @return The result of playing the selected move
+ */
+template <Player P>
+int Mtcs::Node::Descend(Position* position,
+                        GameHistory* history,
+                        MemoryPool<Node>* pool,
+                        std::size_t ply,
+                        std::uint32_t* predicted,
+                        std::uint32_t visits) {
+    if (!expanded_.load(std::memory_order_acquire)) {
+        Lock();
+
+        // Another thread may have expanded this node while we waited
+
+        const bool expanded = expanded_.load(std::memory_order_relaxed) ||
+                              Expand<P>(*position, pool);
+
+        Unlock();
+
+        if (!expanded) {
+            predicted[ply] = kNullMove;
+            return 0;
+        }
+    }
+
+    if (num_childs_ == 0u) {
         predicted[ply] = kNullMove;
 
         const Result result = GameResult(*position);
         if (result == Result::kDraw) {
             return 0;
         } else {
-            const int score = IsLostBy<P>(*position) ? -1 : 1;
-            sum_ += score;
-
-            return score;
+            return IsLostBy<P>(*position) ? -1 : 1;
         }
     }
 
-    // First, search for a child node that has not been visited
+    // Visit any child that hasn't been visited yet, otherwise pick the one
+    // with the best UCB1 score. Child averages are from the opponent's
+    // perspective, hence the negation
 
     Node* selected = nullptr;
-    std::size_t selected_index = 0;
-
-    if (n_moves > num_childs_) {
-        selected = new(pool->Allocate())Node;
-
-        if (selected == nullptr) {
-            return 0;
-        }
-
-        if (num_childs_ == 0u) {
-            childs_ = selected;
-        } else {
-            End()->next_ = selected;
-        }
 
-        selected_index = num_childs_;
+    double best = -kInfinityF64;
 
-        num_childs_++;
-    } else {
-        // All nodes have been visited. Compute their UCB1 scores
+    const double log_visits = std::log(visits);
 
-        double best = -kInfinityF64;
-        std::size_t index = 0;
+    for (Node* node = childs_; node < childs_ + num_childs_; node++) {
+        const std::uint32_t child_visits = node->Visits();
 
-        for (Node* node = childs_; node != nullptr; node = node->next_) {
-            const double ucb1 = node->Average() +
-                2.0 * std::sqrt(std::log(visits_) / node->visits_);
+        if (child_visits == 0u) {
+            selected = node;
+            break;
+        }
 
-            if (ucb1 > best) {
-                selected = node;
-                selected_index = index;
-                best = ucb1;
-            }
+        const double ucb1 = -node->Average() +
+            2.0 * std::sqrt(log_visits / child_visits);
 
-            index++;
+        if (ucb1 > best) {
+            selected = node;
+            best = ucb1;
         }
     }
 
-    const std::uint32_t selected_move = moves[selected_index];
+    const std::uint32_t selected_move = selected->move_;
 
     predicted[ply] = selected_move;
 
-    position->MakeMove<P>(selected_move, ply);
+    history->Push(position->Hash());
+
+    Position::UndoInfo undo;
+    position->MakeMove<P>(selected_move, &undo);
 
     const int result = -selected->Select<util::opponent<P>()>(position,
+                                                              history,
                                                               pool,
                                                               ply+1,
                                                               predicted);
 
-    position->UnMakeMove<P>(selected_move, ply);
+    position->UnMakeMove<P>(selected_move, undo);
 
-    sum_ += result;
+    history->Pop();
 
     return result;
 }
 
+/**
+ * @brief Create every child of this node in a single block. The caller must
+ *        hold the lock on this node
+ *
+ * @param position The position at this node
+ * @param pool     The memory pool to allocate the children from
+ *
+ * @return True on success, false if out of memory
+ */
+template <Player P>
+bool Mtcs::Node::Expand(const Position& position, MemoryPool<Node>* pool) {
+    std::array<std::uint32_t, kMaxMoves> moves;
+
+    const std::size_t n_moves = position.InCheck<P>() ?
+            GenerateCheckEvasions<P>(position, moves.data()) :
+            GenerateLegalMoves<P>(position, moves.data());
+
+    Node* childs = nullptr;
+
+    if (n_moves > 0u) {
+        childs = pool->Allocate(n_moves);
+        if (childs == nullptr) return false;
+
+        for (std::size_t i = 0; i < n_moves; i++) {
+            new(&childs[i]) Node;
+            childs[i].move_ = moves[i];
+        }
+    }
+
+    childs_ = childs;
+    num_childs_ = static_cast<std::uint8_t>(n_moves);
+
+    expanded_.store(true, std::memory_order_release);
+
+    return true;
+}
+
 /**
  * @brief Determine if the specified player has won
  *
@@ -267,75 +466,117 @@ int Mtcs::ComputeWin(const Position& position) {
 }
 
 /**
- * @brief Perform the selection step at the root node
+ * @brief Expand the children of the root node, unless this was already done
+ *        by an earlier search
  *
- * @tparam P The player whose turn it is
+ * @tparam P The player to move at the root
  *
- * @param position The current position
+ * @return True on success, false if out of memory
+ */
+template <Player P>
+bool Mtcs::ExpandRoot() {
+    return root_node_.expanded_.load() ||
+        root_node_.Expand<P>(root_, node_pool_.get());
+}
+
+/**
+ * @brief Try to reuse the existing tree for a new search. This succeeds if
+ *        \a position is reached from the current root by one or two moves
+ *
+ * @tparam P The player to move at the current root
  *
- * @return Score and best move from this position
+ * @param position The root position of the new search
+ *
+ * @return True if the matching subtree was made the new root. All other
+ *         subtrees are returned to the pool
  */
 template <Player P>
-std::pair<double, std::uint32_t> Mtcs::SelectRoot(Position* position) {
-    std::array<std::uint32_t, kMaxMoves> moves;
+bool Mtcs::Reuse(const Position& position) {
+    constexpr Player O = util::opponent<P>();
 
-    const std::size_t n_moves = position->InCheck<P>() ?
-            GenerateCheckEvasions<P>(*position, moves.data()) :
-            GenerateLegalMoves<P>(*position, moves.data());
+    Position pos(root_);
 
-    iterations_++;
+    Node* const childs = root_node_.childs_;
 
-#if DEBUG_TRACE==1
-    if (iterations_ >= 1999)
-    logger_->Write("Iteration %zu\n", iterations_);
-#endif
+    for (Node* child = childs; child < childs + root_node_.num_childs_;
+         child++) {
+        Node* found = nullptr;
 
-    // First, search for a child node that has not been visited
+        Position::UndoInfo undo;
+        pos.MakeMove<P>(child->move_, &undo);
 
-    std::shared_ptr<Node> selected;
-    std::size_t selected_index = 0;
+        if (pos == position) {
+            found = child;
+        } else {
+            for (Node* grandchild = child->childs_;
+                 grandchild < child->childs_ + child->num_childs_;
+                 grandchild++) {
+                Position::UndoInfo grandchild_undo;
+                pos.MakeMove<O>(grandchild->move_, &grandchild_undo);
+                const bool match = pos == position;
+                pos.UnMakeMove<O>(grandchild->move_, grandchild_undo);
+
+                if (match) {
+                    found = grandchild;
+                    break;
+                }
+            }
+        }
 
-    if (n_moves > childs_.size()) {
-        selected.reset(new Node());
+        pos.UnMakeMove<P>(child->move_, undo);
 
-        if (selected == nullptr) {
-            return std::make_pair<double, std::uint32_t>(0, 0);
+        if (found != nullptr) {
+            Promote(found);
+            root_ = position;
+            return true;
         }
+    }
 
-        selected_index = childs_.size();
+    return false;
+}
 
-        childs_.push_back(selected);
-#if DEBUG_TRACE==1
-        if (iterations_ >= 1999)
-        logger_->Write("(Root): Unexplored child %zu: %s\n",
-                       selected_index,
-                       util::ToLongAlgebraic(moves[selected_index]).c_str());
-#endif
-    } else {
-        // All nodes have been visited. Compute their UCB1 scores
+/**
+ * @brief Perform the selection step at the root node
+ *
+ * @tparam P The player whose turn it is
+ *
+ * @param position The current position
+ * @param history  The positions leading to the root
+ */
+template <Player P>
+void Mtcs::SelectRoot(Position* position, GameHistory* history) {
+    iterations_.fetch_add(1, std::memory_order_relaxed);
 
-        double best = -kInfinityF64;
-        std::size_t index = 0;
+    const std::size_t root_visits =
+        root_visits_.fetch_add(1, std::memory_order_relaxed) + 1;
 
-        for (std::shared_ptr<Node>& node : childs_) {
-            const double ucb1 = node->Average() +
-                2.0 * std::sqrt(std::log(iterations_) / node->Visits());
+    // Every root child was expanded up front. Visit any that haven't been
+    // visited yet, otherwise pick the one with the best UCB1 score
 
-            if (ucb1 > best) {
-                selected = node;
-                selected_index = index;
-                best = ucb1;
-            }
+    Node* const childs = root_node_.childs_;
+
+    Node* selected = nullptr;
+
+    double best = -kInfinityF64;
 
-            index++;
+    const double log_visits = std::log(root_visits);
+
+    for (Node* node = childs; node < childs + root_node_.num_childs_;
+         node++) {
+        const std::uint32_t visits = node->Visits();
+
+        if (visits == 0u) {
+            selected = node;
+            break;
+        }
+
+        const double ucb1 = -node->Average() +
+            2.0 * std::sqrt(log_visits / visits);
+
+        if (ucb1 > best) {
+            selected = node;
+            best = ucb1;
         }
-#if DEBUG_TRACE==1
-        if (iterations_ >= 1999)
-        logger_->Write("UCB1( selected => %s) = %0.6f with %u visits\n",
-                       util::ToLongAlgebraic(moves[selected_index]).c_str(),
-                       best,
-                       childs_[selected_index]->Visits());
-#endif
     }
 
     // Step into the selected node. Note that playouts are never done at
@@ -345,63 +586,156 @@ std::pair<double, std::uint32_t> Mtcs::SelectRoot(Position* position) {
 
     std::array<std::uint32_t, kMaxPly> predicted;
 
-    position->MakeMove<P>(moves[selected_index], ply);
+    predicted[ply] = selected->move_;
+
+    history->Push(position->Hash());
+
+    Position::UndoInfo undo;
+    position->MakeMove<P>(selected->move_, &undo);
 
     selected->Select<util::opponent<P>()>(position,
+                                          history,
                                           node_pool_.get(),
                                           ply+1,
                                           predicted.data());
 
-    position->UnMakeMove<P>(moves[selected_index], ply);
+    position->UnMakeMove<P>(selected->move_, undo);
 
-    // Select the move corresponding to the node with the maximum visits
+    history->Pop();
 
-    auto iter = std::max_element(childs_.begin(), childs_.end(),
-                                 [](const std::shared_ptr<Node>& a,
-                                    const std::shared_ptr<Node>& b) {
-                                        return a->Visits() < b->Visits();
-                                 });
+    // The selected line ends where the playout started
 
-    const auto index = std::distance(childs_.begin(), iter);
+    std::size_t length = 1;
+    while (predicted[length] != kNullMove) length++;
 
-    return std::make_pair(childs_[index]->Average(), moves[index]);
+    std::size_t seldepth = seldepth_.load(std::memory_order_relaxed);
+
+    while (length > seldepth &&
+           !seldepth_.compare_exchange_weak(seldepth, length,
+                                            std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Play a uniformly random legal move
+ *
+ * @tparam P The player to move
+ *
+ * @param position The current position
+ * @param history  Records the position before the move
+ * @param ply      The depth at this position
+ * @param played   Records the move at index \a ply
+ * @param undo     Records what is needed to unmake it at index \a ply
+ *
+ * @return True if a move was made, false if \a P has no legal moves
+ */
+template <Player P>
+bool Mtcs::PlayRandomMove(Position* position,
+                          GameHistory* history,
+                          std::size_t ply,
+                          std::uint32_t* played,
+                          Position::UndoInfo* undo) {
+    std::array<std::uint32_t, kMaxMoves> moves;
+
+    const std::size_t n_moves = position->InCheck<P>() ?
+        GenerateCheckEvasions<P>(*position, moves.data()) :
+        GenerateLegalMoves<P>(*position, moves.data());
+
+    if (n_moves == 0u) return false;
+
+    const std::uint32_t move = moves[random(n_moves)];
+
+    history->Push(position->Hash());
+
+    position->MakeMove<P>(move, &undo[ply]);
+
+    played[ply] = move;
+
+    return true;
 }
 
 /**
  * @brief Run the simulation step of Monte Carlo Tree Search
  *
+ * Random moves are played two plies at a time, so the player to move is
+ * known at compile time, and then taken back in reverse order. The playout
+ * ends early once the game is drawn. One that runs out of plies is
+ * adjudicated by static evaluation
+ *
  * @tparam P       The player whose turn it is
  * @param position Starting position to simulate from
+ * @param history  The positions leading to \a position
  * @param ply      The depth at this position
  *
- * @return +1 if P has won, -1 if P has lost, 0 otherwise
+ * @return +1 if P has won or leads by kAdjudicationMargin when the playout
+ *         is cut off, -1 if the same holds for the opponent, 0 otherwise
  */
 template <Player P>
-std::int32_t Mtcs::Simulate(Position* position, std::size_t ply) {
+std::int32_t Mtcs::Simulate(Position* position, GameHistory* history,
+                            std::size_t ply) {
+    constexpr Player O = util::opponent<P>();
+
     constexpr std::size_t max_ply = 200;
     static_assert(max_ply > 0u && max_ply <= kMaxPly);
 
-    if (ply >= max_ply) return 0;
+    std::array<std::uint32_t, max_ply> played;
+    std::array<Position::UndoInfo, max_ply> undo;
 
-    std::array<std::uint32_t, kMaxMoves> moves;
+    std::size_t end = ply;
+    bool game_over = false;
+    bool drawn = false;
 
-    const std::size_t n_moves = position->InCheck<P>() ?
-        GenerateCheckEvasions<P>(*position, moves.data()) :
-        GenerateLegalMoves<P>(*position, moves.data());
+    while (end < max_ply) {
+        drawn = history->IsDraw(*position, end);
+        if (drawn) break;
+
+        if (!PlayRandomMove<P>(position, history, end, played.data(),
+                               undo.data())) {
+            game_over = true;
+            break;
+        }
+
+        if (++end == max_ply) break;
+
+        drawn = history->IsDraw(*position, end);
+        if (drawn) break;
 
-    if (n_moves == 0u) {
-        return -ComputeWin<util::opponent<P>()>(*position);
+        if (!PlayRandomMove<O>(position, history, end, played.data(),
+                               undo.data())) {
+            game_over = true;
+            break;
+        }
+
+        end++;
     }
 
-    const std::size_t selected_index = random(n_moves);
+    std::int32_t result = 0;
+
+    if (game_over) {
+        result = ComputeWin<P>(*position);
+    } else if (!drawn) {
+        const int score = Evaluate<P>(*position);
 
-    const std::uint32_t move = moves[selected_index];
+        if (score >= kAdjudicationMargin) {
+            result = 1;
+        } else if (score <= -kAdjudicationMargin) {
+            result = -1;
+        }
+    }
+
+    // Moves at an even distance from the starting ply were made by P
 
-    position->MakeMove<P>(move, ply);
+    while (end > ply) {
+        end--;
 
-    const int result = -Simulate<util::opponent<P>()>(position, ply+1);
+        if ((end - ply) % 2 == 0u) {
+            position->UnMakeMove<P>(played[end], undo[end]);
+        } else {
+            position->UnMakeMove<O>(played[end], undo[end]);
+        }
 
-    position->UnMakeMove<P>(move, ply);
+        history->Pop();
+    }
 
     return result;
 }
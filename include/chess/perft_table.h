@@ -0,0 +1,98 @@
+/**
+ *  \file   perft_table.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#ifndef CHESS_PERFT_TABLE_H_
+#define CHESS_PERFT_TABLE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace chess {
+/**
+ * @brief A cache of perft subtree sizes, shared by all perft threads
+ *
+ * Entries are keyed on a position's hash key plus the depth remaining below
+ * it. Like \ref TranspositionTable, each slot stores its data word alongside
+ * the key XOR'd with that data, so a slot torn by concurrent writers reads
+ * as a miss and no locking is needed
+ */
+class PerftTable final {
+public:
+    /**
+     * The number of slots per bucket. Each bucket fills one cache line
+     */
+    static constexpr std::size_t kBucketSize = 4;
+
+    /**
+     * The deepest subtree which can be stored, in plies
+     */
+    static constexpr std::uint32_t kMaxDepth = 255;
+
+    /**
+     * The largest subtree size which can be stored
+     */
+    static constexpr std::uint64_t kMaxNodes = (std::uint64_t(1) << 56) - 1;
+
+    explicit PerftTable(std::size_t megabytes);
+
+    PerftTable(const PerftTable& table)            = delete;
+    PerftTable(PerftTable&& table)                 = delete;
+    PerftTable& operator=(const PerftTable& table) = delete;
+    PerftTable& operator=(PerftTable&& table)      = delete;
+
+    ~PerftTable() = default;
+
+    void Clear() noexcept;
+
+    bool Probe(std::uint64_t key, std::uint32_t depth,
+               std::uint64_t* nodes) const noexcept;
+
+    void Resize(std::size_t megabytes);
+
+    std::size_t Size() const noexcept;
+
+    void Store(std::uint64_t key, std::uint32_t depth,
+               std::uint64_t nodes) noexcept;
+
+private:
+    /**
+     * A single slot. The data word holds the depth in its top 8 bits and the
+     * node count below that; a depth of zero marks an empty slot
+     */
+    struct Slot {
+        std::atomic<std::uint64_t> check;
+        std::atomic<std::uint64_t> data;
+    };
+
+    /**
+     * A group of slots sharing a cache line. A key may be stored in any
+     * slot of the bucket it hashes to
+     */
+    struct alignas(64) Bucket {
+        std::array<Slot, kBucketSize> slots;
+    };
+
+    static_assert(sizeof(Bucket) == 64);
+
+    Bucket& BucketFor(std::uint64_t key) const noexcept;
+
+    /**
+     * The table itself. The number of buckets is a power of two
+     */
+    std::unique_ptr<Bucket[]> buckets_;
+
+    /**
+     * \ref buckets_ size minus one, used to index by key
+     */
+    std::size_t mask_;
+};
+
+}  // namespace chess
+
+#endif  // CHESS_PERFT_TABLE_H_
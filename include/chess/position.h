@@ -10,15 +10,25 @@
 #include <array>
 #include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 
 #include "chess/attacks.h"
 #include "chess/chess.h"
 #include "chess/data_tables.h"
 #include "chess/util.h"
 
+/**
+ * Set to 1 to compare the incrementally updated hash signature against a
+ * full recompute after every MakeMove()/UnMakeMove()
+ */
+#ifndef CHESS_VERIFY_HASH
+#define CHESS_VERIFY_HASH 0
+#endif
+
 namespace chess {
 /**
  * Represents a chess position
@@ -127,8 +137,9 @@ public:
         void Move(Piece piece, Square from, Square to) noexcept;
 
         constexpr Square        KingSquare() const noexcept;
-        constexpr std::int16_t  Material()   const noexcept;
-        constexpr std::uint64_t Occupied()   const noexcept;
+        constexpr std::int16_t  Material()    const noexcept;
+        constexpr std::uint64_t Occupied()    const noexcept;
+        constexpr std::int16_t  PieceSquare() const noexcept;
 
         void InhibitCastle() noexcept;
 
@@ -144,6 +155,9 @@ public:
         /** The sum of this player's material */
         std::int16_t material_;
 
+        /** The sum of this player's piece-square bonuses */
+        std::int16_t piece_square_;
+
         /** The squares occupied by the player */
         std::uint64_t occupied_;
 
@@ -151,6 +165,28 @@ public:
         PieceSet pieces_;
     };
 
+    /**
+     * @brief The state that MakeMove() overwrites and cannot be recovered
+     *        from the move itself. Callers keep one per ply, e.g. on the
+     *        stack of a recursive search, and hand it back to UnMakeMove()
+     */
+    struct UndoInfo {
+        /** Hash signature before the move */
+        std::uint64_t hash;
+
+        /** Half move number before the move */
+        int half_move_number;
+
+        /** En passant target before the move */
+        Square ep_target;
+
+        /** Long castling rights before the move, indexed by player */
+        bool can_castle_long[2];
+
+        /** Short castling rights before the move, indexed by player */
+        bool can_castle_short[2];
+    };
+
     static const char kDefaultFen[];
 
     Position();
@@ -167,6 +203,8 @@ public:
 
     constexpr std::uint64_t EnPassantTargetMask() const;
 
+    std::uint64_t ComputeHash() const noexcept;
+
     constexpr int FullMoveNumber() const noexcept;
 
     std::string GetFen() const;
@@ -181,11 +219,16 @@ public:
 
     constexpr int HalfMoveNumber() const noexcept;
 
+    constexpr std::uint64_t Hash() const noexcept;
+
     template <Player player>
     constexpr bool InCheck() const noexcept;
 
     template <Player player>
-    void MakeMove(std::int32_t move, std::uint32_t ply) noexcept;
+    void CopyMake(const Position& parent, std::int32_t move) noexcept;
+
+    template <Player player>
+    void MakeMove(std::int32_t move, UndoInfo* undo) noexcept;
 
     constexpr std::uint64_t Occupied() const noexcept;
 
@@ -205,7 +248,7 @@ public:
     constexpr bool UnderAttack(Square square) const noexcept;
 
     template<Player player>
-    void UnMakeMove(std::int32_t move, std::uint32_t ply) noexcept;
+    void UnMakeMove(std::int32_t move, const UndoInfo& undo) noexcept;
 
     bool operator==(const Position& other) const noexcept;
 
@@ -213,6 +256,11 @@ public:
     static FenError Validate(const Position& pos);
 
 private:
+    constexpr int CastleRights() const noexcept;
+
+    template <Player player>
+    constexpr std::uint64_t EnPassantKey() const noexcept;
+
     /**
      * En-passant move information
      */
@@ -230,31 +278,6 @@ private:
         Square target;
     };
 
-    /**
-     * Maintains a record of select information over multiple plies
-     */
-    struct History {
-        /**
-         * Stored long castle rights info
-         */
-        bool can_castle_long[2][kMaxPly];
-
-        /**
-         * Stored short castle rights info
-         */
-        bool can_castle_short[2][kMaxPly];
-
-        /**
-         * Stored en passant target
-         */
-        Square ep_target[kMaxPly];
-
-        /**
-         * Consecutive irreversible moves
-         */
-        int half_move_number[kMaxPly];
-    };
-
     /** The side playing as Black */
     PlayerInfo<Player::kBlack> black_;
 
@@ -273,8 +296,8 @@ private:
     /** The position's half move number */
     int half_move_number_;
 
-    /** Position history across multiple plies */
-    History history_;
+    /** Zobrist hash signature, updated incrementally with each move */
+    std::uint64_t hash_;
 
     /** All pieces currently on board (for both sides) */
     Piece pieces_[65];
@@ -283,6 +306,12 @@ private:
     Player to_move_;
 };
 
+/**
+ * Copy-make search copies positions at every node, so copying must stay a
+ * plain memory copy
+ */
+static_assert(std::is_trivially_copyable_v<Position>);
+
 /**
  * @return The square from which a pawn can currently be captured
  * en passant (set for every pawn double advancement)
@@ -300,6 +329,39 @@ constexpr std::uint64_t Position::EnPassantTargetMask() const {
             0 : std::uint64_t(1) << en_passant_target_;
 }
 
+/**
+ * @return The castling rights of both players packed into 4 bits, in the
+ *         order expected by \ref data_tables::kZobristCastle
+ */
+constexpr int Position::CastleRights() const noexcept {
+    return (white_.CanCastleShort() ? 1 : 0) |
+           (white_.CanCastleLong()  ? 2 : 0) |
+           (black_.CanCastleShort() ? 4 : 0) |
+           (black_.CanCastleLong()  ? 8 : 0);
+}
+
+/**
+ * Get the Zobrist key for the current en passant target. The target only
+ * contributes to the hash signature if the player on move has a pawn that
+ * can actually capture there, so that transpositions differing only by a
+ * meaningless en passant square hash the same
+ *
+ * @tparam player The player whose turn it is
+ *
+ * @return The en passant key, or zero if there is none
+ */
+template <Player player>
+constexpr std::uint64_t Position::EnPassantKey() const noexcept {
+    if (en_passant_target_ == Square::Overflow) return 0;
+
+    const std::uint64_t capturers =
+        data_tables::kPawnAttacks<util::opponent<player>()>[en_passant_target_]
+            & GetPlayerInfo<player>().Pawns();
+
+    return capturers == 0u ? 0 :
+        data_tables::kZobristEnPassant[util::GetFile(en_passant_target_)];
+}
+
 /**
  * @return The position's current full-move number
  */
@@ -363,6 +425,13 @@ constexpr int Position::HalfMoveNumber() const noexcept {
     return half_move_number_;
 }
 
+/**
+ * @return The Zobrist hash signature of this position
+ */
+constexpr std::uint64_t Position::Hash() const noexcept {
+    return hash_;
+}
+
 /**
  * @return True if the given player is currently in check
  */
@@ -372,39 +441,67 @@ constexpr bool Position::InCheck() const noexcept {
             GetPlayerInfo<player>().KingSquare());
 }
 
+/**
+ * Copy a position and make a move in the copy. Nothing is saved for undoing
+ * the move, so a search that copies positions instead of unmaking moves
+ * needs no undo stack
+ *
+ * @param[in] parent The position to copy
+ * @param[in] move   The move to make, which must be legal in \a parent
+ */
+template<Player who>
+inline void Position::CopyMake(const Position& parent,
+                               std::int32_t move) noexcept {
+    *this = parent;
+
+    // The optimizer drops the stores to this
+    UndoInfo unused;
+    MakeMove<who>(move, &unused);
+}
+
 /**
  * Make a move
  *
- * @param[in] move The move to make
- * @param[in] ply  The current search ply
+ * @param[in]  move The move to make
+ * @param[out] undo Receives what UnMakeMove() needs to take \a move back
  */
 template<Player who>
-inline void Position::MakeMove(std::int32_t move, std::uint32_t ply) noexcept {
+inline void Position::MakeMove(std::int32_t move, UndoInfo* undo) noexcept {
     /*
      * Extract player/opponent info
      */
     auto& player = GetPlayerInfo<who>();
     auto& opponent = GetPlayerInfo<util::opponent<who>()>();
 
-    history_.half_move_number[ply] = HalfMoveNumber();
+    undo->half_move_number = HalfMoveNumber();
+    undo->hash = hash_;
 
     /*
      * Back up castling rights and en passant target. Later, when we
      * UnMakeMove(), we will have a record of what these were
      */
-    history_.can_castle_long [util::index<Player::kBlack>()][ply] =
+    undo->can_castle_long [util::index<Player::kBlack>()] =
         black_.CanCastleLong();
-    history_.can_castle_long [util::index<Player::kWhite>()][ply] =
+    undo->can_castle_long [util::index<Player::kWhite>()] =
         white_.CanCastleLong();
 
-    history_.can_castle_short[util::index<Player::kBlack>()][ply] =
+    undo->can_castle_short[util::index<Player::kBlack>()] =
         black_.CanCastleShort();
-    history_.can_castle_short[util::index<Player::kWhite>()][ply] =
+    undo->can_castle_short[util::index<Player::kWhite>()] =
         white_.CanCastleShort();
 
     bool castling_changed = false;
 
-    history_.ep_target[ply] = en_passant_target_;
+    undo->ep_target = en_passant_target_;
+
+    /*
+     * Remove the outgoing castling rights and en passant target from the
+     * hash signature. The updated ones are folded back in further below
+     */
+    const int castle_rights = CastleRights();
+
+    std::uint64_t hash =
+        hash_ ^ EnPassantKey<who>() ^ data_tables::kZobristToMove;
 
     /*
      * Extract move information
@@ -431,6 +528,9 @@ inline void Position::MakeMove(std::int32_t move, std::uint32_t ply) noexcept {
     if (moved != Piece::PAWN) {
         pieces_[to] = moved;
         player.Move(moved, from, to);
+
+        hash ^= data_tables::kZobristPiece<who>[moved][from] ^
+                data_tables::kZobristPiece<who>[moved][to];
     }
 
     switch (moved) {
@@ -447,6 +547,9 @@ inline void Position::MakeMove(std::int32_t move, std::uint32_t ply) noexcept {
         pieces_[to] = promoted;
         player.Drop(promoted, to);
 
+        hash ^= data_tables::kZobristPiece<who>[Piece::PAWN][from] ^
+                data_tables::kZobristPiece<who>[promoted][to];
+
         /*
          * If this was a double advance, set the en passant target
          */
@@ -473,11 +576,17 @@ inline void Position::MakeMove(std::int32_t move, std::uint32_t ply) noexcept {
                 pieces_[to + 1] = Piece::ROOK;
 
                 player.template Move<Piece::ROOK>(to - 1, to + 1);
+
+                hash ^= data_tables::kZobristPiece<who>[Piece::ROOK][to - 1] ^
+                        data_tables::kZobristPiece<who>[Piece::ROOK][to + 1];
             } else {
                 pieces_[to + 2] = Piece::EMPTY;
                 pieces_[to - 1] = Piece::ROOK;
 
                 player.template Move<Piece::ROOK>(to + 2, to - 1);
+
+                hash ^= data_tables::kZobristPiece<who>[Piece::ROOK][to + 2] ^
+                        data_tables::kZobristPiece<who>[Piece::ROOK][to - 1];
             }
         }
 
@@ -501,15 +610,24 @@ inline void Position::MakeMove(std::int32_t move, std::uint32_t ply) noexcept {
           case Piece::PAWN:
             if (opponent.Occupied() & data_tables::kSetMask[to]) {
                 opponent.template Lift<Piece::PAWN>(to);
+
+                hash ^= data_tables::kZobristPiece<
+                            util::opponent<who>()>[Piece::PAWN][to];
             } else {
                 const Square minus8 = data_tables::kMinus8<who>[to];
                 pieces_[minus8] = Piece::EMPTY;
                 opponent.template Lift<Piece::PAWN>(minus8);
+
+                hash ^= data_tables::kZobristPiece<
+                            util::opponent<who>()>[Piece::PAWN][minus8];
             }
             break;
           case Piece::ROOK:
             opponent.template Lift<Piece::ROOK>(to);
 
+            hash ^= data_tables::kZobristPiece<
+                        util::opponent<who>()>[Piece::ROOK][to];
+
             if (opponent.CanCastle()) {
                 if (to == data_tables::kRookHomeA<util::opponent<who>()>) {
                     opponent.CanCastleLong() = false;
@@ -521,6 +639,9 @@ inline void Position::MakeMove(std::int32_t move, std::uint32_t ply) noexcept {
             break;
           default:
             opponent.Lift(captured, to);
+
+            hash ^= data_tables::kZobristPiece<
+                        util::opponent<who>()>[captured][to];
             break;
         }
     } else if (moved != Piece::PAWN
@@ -532,6 +653,14 @@ inline void Position::MakeMove(std::int32_t move, std::uint32_t ply) noexcept {
         util::IncrementIfBlack<who>(full_move_number_);
 
     to_move_ = util::opponent<who>();
+
+    hash_ = hash ^ data_tables::kZobristCastle[castle_rights]
+                 ^ data_tables::kZobristCastle[CastleRights()]
+                 ^ EnPassantKey<util::opponent<who>()>();
+
+#if CHESS_VERIFY_HASH==1
+    if (hash_ != ComputeHash()) std::abort();
+#endif
 }
 
 /**
@@ -681,32 +810,33 @@ constexpr bool Position::UnderAttack(Square square) const noexcept {
  * Undo a move
  *
  * @param[in] move The move to undo
- * @param[in] ply  The current search ply
+ * @param[in] undo What MakeMove() saved when \a move was made
  */
 template<Player who> inline
-void Position::UnMakeMove(std::int32_t move, std::uint32_t ply) noexcept {
+void Position::UnMakeMove(std::int32_t move, const UndoInfo& undo) noexcept {
     /*
      * Extract player/opponent info
      */
     auto& player = GetPlayerInfo<who>();
     auto& opponent = GetPlayerInfo<util::opponent<who>()>();
 
-    half_move_number_ = history_.half_move_number[ply];
+    half_move_number_ = undo.half_move_number;
+    hash_ = undo.hash;
 
     /*
      * Restore castling rights and en passant target
      */
     black_.CanCastleLong() =
-        history_.can_castle_long [util::index<Player::kBlack>()][ply];
+        undo.can_castle_long [util::index<Player::kBlack>()];
     white_.CanCastleLong() =
-        history_.can_castle_long [util::index<Player::kWhite>()][ply];
+        undo.can_castle_long [util::index<Player::kWhite>()];
 
     black_.CanCastleShort() =
-        history_.can_castle_short[util::index<Player::kBlack>()][ply];
+        undo.can_castle_short[util::index<Player::kBlack>()];
     white_.CanCastleShort() =
-        history_.can_castle_short[util::index<Player::kWhite>()][ply];
+        undo.can_castle_short[util::index<Player::kWhite>()];
 
-    en_passant_target_ = history_.ep_target[ply];
+    en_passant_target_ = undo.ep_target;
 
     /*
      * Extract move information
@@ -789,6 +919,10 @@ void Position::UnMakeMove(std::int32_t move, std::uint32_t ply) noexcept {
         util::DecrementIfBlack<who>(full_move_number_);
 
     to_move_ = who;
+
+#if CHESS_VERIFY_HASH==1
+    if (hash_ != ComputeHash()) std::abort();
+#endif
 }
 
 /**
@@ -799,6 +933,7 @@ Position::PlayerInfo<player>::PlayerInfo() :
     can_castle_long_(false),
     can_castle_short_(false),
     material_(0),
+    piece_square_(0),
     occupied_(0),
     pieces_() {
 }
@@ -944,6 +1079,7 @@ void Position::PlayerInfo<player>::Drop(Square square) noexcept {
     pieces_.Put<piece>(square);
 
     material_ += data_tables::kPieceValue[piece];
+    piece_square_ += data_tables::kPieceSquare<player>[piece][square];
 }
 
 /**
@@ -965,6 +1101,7 @@ void Position::PlayerInfo<player>::Drop(Piece piece, Square square) noexcept {
     pieces_.king_square[piece] = square;
 
     material_ += data_tables::kPieceValue[piece];
+    piece_square_ += data_tables::kPieceSquare<player>[piece][square];
 }
 
 /**
@@ -983,6 +1120,7 @@ void Position::PlayerInfo<player>::Lift(Square square) noexcept {
     pieces_.pieces64[piece] &= data_tables::kClearMask[square];
 
     material_ -= data_tables::kPieceValue[piece];
+    piece_square_ -= data_tables::kPieceSquare<player>[piece][square];
 }
 
 /**
@@ -1001,6 +1139,7 @@ void Position::PlayerInfo<player>::Lift(Piece piece, Square square) noexcept {
     pieces_.pieces64[piece] &= data_tables::kClearMask[square];
 
     material_ -= data_tables::kPieceValue[piece];
+    piece_square_ -= data_tables::kPieceSquare<player>[piece][square];
 }
 
 /**
@@ -1021,6 +1160,9 @@ void Position::PlayerInfo<player>::Move(Square from, Square to) noexcept {
     pieces_.pieces64[piece] ^= clear_set;
     occupied_ ^= clear_set;
     pieces_.king_square[piece] = to;
+
+    piece_square_ += data_tables::kPieceSquare<player>[piece][to] -
+                     data_tables::kPieceSquare<player>[piece][from];
 }
 
 /**
@@ -1042,6 +1184,9 @@ void Position::PlayerInfo<player>::Move(Piece piece, Square from, Square to)
     pieces_.pieces64[piece] ^= clear_set;
     occupied_ ^= clear_set;
     pieces_.king_square[piece] = to;
+
+    piece_square_ += data_tables::kPieceSquare<player>[piece][to] -
+                     data_tables::kPieceSquare<player>[piece][from];
 }
 
 /**
@@ -1061,6 +1206,15 @@ constexpr std::int16_t Position::PlayerInfo<player>::Material() const
     return material_;
 }
 
+/**
+ * @return The sum of the piece-square bonuses of all of this player's pieces
+ */
+template <Player player>
+constexpr std::int16_t Position::PlayerInfo<player>::PieceSquare() const
+    noexcept {
+    return piece_square_;
+}
+
 /**
  * Forbid this player from castling in the future
  */
@@ -1080,6 +1234,7 @@ template <Player player>
 bool Position::PlayerInfo<player>::operator==(const PlayerInfo& other) const
     noexcept {
     bool same = material_ == other.material_ &&
+                piece_square_ == other.piece_square_ &&
                 occupied_ == other.occupied_ &&
                 pieces_ == other.pieces_;
 
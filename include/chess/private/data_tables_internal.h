@@ -1185,6 +1185,60 @@ constexpr Square InitPlus9<Player::kBlack>(int square) {
  * @}
  */
 
+/**
+ * Piece-square bonuses from White's point of view, indexed by square with
+ * H1 = 0. Only knights and pawns have them: knights are drawn toward the
+ * center, and pawns are rewarded for advancing
+ *
+ * @{
+ */
+constexpr std::int16_t kKnightSquareBonus[64] = {
+     0,  0,  0,  0,  0,  0,  0, 0,
+     0,  0,  0,  0,  0,  0,  0, 0,
+     0,  0,  5, 10, 10,  5,  0, 0,
+     0,  5, 20, 30, 30, 20,  5, 0,
+     0, 10, 20, 40, 40, 20, 10, 0,
+     0, 10, 20, 40, 40, 20, 10, 0,
+     0, 10, 15, 20, 20, 15, 10, 0,
+     0,  5,  5, 10, 10,  5,  5, 0
+};
+
+constexpr std::int16_t kPawnSquareBonus[64] = {
+     0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,
+     1,  2,  2,  2,  2,  2,  2,  1,
+     5, 10, 10, 10, 10, 10, 10,  5,
+    10, 20, 20, 20, 20, 20, 20, 10,
+    25, 50, 50, 50, 50, 50, 50, 25,
+    35, 70, 70, 70, 70, 70, 70, 35,
+     0,  0,  0,  0,  0,  0,  0,  0
+};
+/**
+ * @}
+ */
+
+/**
+ * Build the piece-square table for one player. Black's bonuses are White's
+ * mirrored top to bottom
+ *
+ * @tparam P The player who owns the pieces
+ *
+ * @return The bonus for each [piece][square]
+ */
+template <Player P>
+constexpr std::array<std::array<std::int16_t,64>,7> InitPieceSquare() {
+    std::array<std::array<std::int16_t,64>,7> table = {};
+
+    for (int square = 0; square < 64; square++) {
+        const int from_white = P == Player::kWhite ? square : square ^ 56;
+
+        table[Piece::KNIGHT][square] = kKnightSquareBonus[from_white];
+        table[Piece::PAWN  ][square] = kPawnSquareBonus[from_white];
+    }
+
+    return table;
+}
+
 /**
  * Given an occupancy bitboard, compute a bishop's mobility
  *
@@ -1381,6 +1435,81 @@ constexpr std::uint64_t InitRaySegment(int square1, int square2) {
 
 }
 
+/**
+ * Generate the n-th output of a SplitMix64 sequence seeded with zero. Each
+ * output depends only on its index, which lets us build every Zobrist key
+ * table independently at compile time
+ *
+ * @param[in] index The position in the sequence
+ *
+ * @return A pseudo-random 64-bit value
+ */
+constexpr std::uint64_t ZobristKey(std::uint64_t index) {
+    std::uint64_t z = (index + 1) * 0x9e3779b97f4a7c15ull;
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+    return z ^ (z >> 31);
+}
+
+/**
+ * Offsets into the SplitMix64 sequence from which each class of Zobrist key
+ * is drawn. Piece keys occupy the first 2 x 6 x 64 slots
+ *
+ * @{
+ */
+constexpr std::uint64_t kZobristCastleIndex    = 2 * 6 * 64;
+constexpr std::uint64_t kZobristEnPassantIndex = kZobristCastleIndex + 4;
+constexpr std::uint64_t kZobristToMoveIndex    = kZobristEnPassantIndex + 8;
+/**
+ * @}
+ */
+
+/**
+ * Get the Zobrist key for a combination of castling rights
+ *
+ * @param[in] rights Bit 0 = White short, bit 1 = White long, bit 2 = Black
+ *                   short, bit 3 = Black long
+ *
+ * @return The XOR of the keys for each castling right present in \a rights
+ */
+constexpr std::uint64_t ZobristCastle(int rights) {
+    std::uint64_t key = 0;
+
+    for (int i = 0; i < 4; i++) {
+        if (rights & (1 << i)) key ^= ZobristKey(kZobristCastleIndex + i);
+    }
+
+    return key;
+}
+
+/**
+ * Get the Zobrist key for an en passant target on the given file
+ *
+ * @param[in] file The file of the en passant target (H-file = 0)
+ *
+ * @return The key for this file
+ */
+constexpr std::uint64_t ZobristEnPassant(int file) {
+    return ZobristKey(kZobristEnPassantIndex + file);
+}
+
+/**
+ * Get the Zobrist key for a piece standing on a particular square
+ *
+ * @tparam P The player who owns the piece
+ *
+ * @param[in] piece  The piece type
+ * @param[in] square The square the piece stands on
+ *
+ * @return The key for this piece and square
+ */
+template <Player P>
+constexpr std::uint64_t ZobristPiece(int piece, int square) {
+    return ZobristKey(util::index<P>() * 6 * 64 + piece * 64 + square);
+}
+
 }  // namespace internal
 }  // namespace data_tables
 }  // namespace chess
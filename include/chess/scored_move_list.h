@@ -0,0 +1,166 @@
+/**
+ *  \file   scored_move_list.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#ifndef CHESS_SCORED_MOVE_LIST_H_
+#define CHESS_SCORED_MOVE_LIST_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "chess/chess.h"
+
+namespace chess {
+/**
+ * @brief A list of moves together with an ordering score for each
+ *
+ * The scores are kept in their own array, parallel to the moves, so that
+ * selecting the best move scans only the scores. Moves are generated
+ * directly into \ref Data(), after which the list is resized to fit
+ */
+class ScoredMoveList final {
+public:
+    ScoredMoveList() noexcept;
+
+    ScoredMoveList(const ScoredMoveList& list)            = default;
+    ScoredMoveList(ScoredMoveList&& list)                 = default;
+    ScoredMoveList& operator=(const ScoredMoveList& list) = default;
+    ScoredMoveList& operator=(ScoredMoveList&& list)      = default;
+
+    ~ScoredMoveList() = default;
+
+    std::uint32_t* Data() noexcept;
+
+    std::uint32_t& Move(std::size_t index) noexcept;
+
+    std::uint32_t PickBest(std::size_t index) noexcept;
+
+    void Resize(std::size_t size) noexcept;
+
+    std::int32_t& Score(std::size_t index) noexcept;
+
+    std::size_t Size() const noexcept;
+
+    void Sort() noexcept;
+
+private:
+    /**
+     * The moves
+     */
+    std::array<std::uint32_t, kMaxMoves> moves_;
+
+    /**
+     * The ordering score of each move. Higher is better
+     */
+    std::array<std::int32_t, kMaxMoves> scores_;
+
+    /**
+     * The number of moves in the list
+     */
+    std::size_t size_;
+};
+
+/**
+ * @brief Constructor. The list starts out empty
+ */
+inline ScoredMoveList::ScoredMoveList() noexcept : size_(0) {
+}
+
+/**
+ * @brief Get the underlying move array, e.g. to generate moves into
+ *
+ * @return The first of kMaxMoves slots
+ */
+inline std::uint32_t* ScoredMoveList::Data() noexcept {
+    return moves_.data();
+}
+
+/**
+ * @brief Access a move
+ *
+ * @param index The index of the move, less than \ref Size()
+ *
+ * @return The move at \a index
+ */
+inline std::uint32_t& ScoredMoveList::Move(std::size_t index) noexcept {
+    return moves_[index];
+}
+
+/**
+ * @brief Move the best of the moves from \a index onward to \a index. This
+ *        is one step of a selection sort, which is cheaper than sorting when
+ *        a cutoff is likely to come early
+ *
+ * @param index Place the best move from [index, Size()) here
+ *
+ * @return The best move
+ */
+inline std::uint32_t ScoredMoveList::PickBest(std::size_t index) noexcept {
+    std::size_t best = index;
+
+    for (std::size_t i = index+1; i < size_; i++) {
+        if (scores_[i] > scores_[best]) best = i;
+    }
+
+    std::swap(moves_[index], moves_[best]);
+    std::swap(scores_[index], scores_[best]);
+
+    return moves_[index];
+}
+
+/**
+ * @brief Set the number of moves, e.g. after generating into \ref Data()
+ *
+ * @param size The new size, at most kMaxMoves
+ */
+inline void ScoredMoveList::Resize(std::size_t size) noexcept {
+    size_ = size;
+}
+
+/**
+ * @brief Access the ordering score of a move
+ *
+ * @param index The index of the move, less than \ref Size()
+ *
+ * @return The score of the move at \a index
+ */
+inline std::int32_t& ScoredMoveList::Score(std::size_t index) noexcept {
+    return scores_[index];
+}
+
+/**
+ * @brief Get the number of moves
+ *
+ * @return The number of moves in the list
+ */
+inline std::size_t ScoredMoveList::Size() const noexcept {
+    return size_;
+}
+
+/**
+ * @brief Sort all moves by descending score. Moves with equal scores keep
+ *        their relative order
+ */
+inline void ScoredMoveList::Sort() noexcept {
+    for (std::size_t i = 1; i < size_; i++) {
+        const std::uint32_t move = moves_[i];
+        const std::int32_t score = scores_[i];
+
+        std::size_t j = i;
+        for (; j > 0 && scores_[j-1] < score; j--) {
+            moves_[j]  = moves_[j-1];
+            scores_[j] = scores_[j-1];
+        }
+
+        moves_[j]  = move;
+        scores_[j] = score;
+    }
+}
+
+}  // namespace chess
+
+#endif  // CHESS_SCORED_MOVE_LIST_H_
@@ -7,16 +7,67 @@
 #ifndef CHESS_SEARCH_H_
 #define CHESS_SEARCH_H_
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
 
+#include "chess/game_history.h"
 #include "chess/position.h"
+#include "chess/stream_channel.h"
+#include "chess/time_manager.h"
 
 namespace chess {
+/**
+ * @brief Search progress, as reported through the UCI "info" command
+ */
+struct SearchInfo {
+    /** The nominal search depth, in plies */
+    int depth = 0;
+
+    /** Occupancy of the search's table or tree in permille, or -1 if none */
+    int hashfull = -1;
+
+    /** True if \ref score is a distance to mate rather than centipawns */
+    bool mate = false;
+
+    /** The number of nodes searched */
+    std::uint64_t nodes = 0;
+
+    /** The principal variation */
+    std::vector<std::uint32_t> pv;
+
+    /**
+     * The score from the perspective of the player to move, in centipawns.
+     * If \ref mate is set, the number of moves to mate instead, negative if
+     * the player to move is getting mated
+     */
+    int score = 0;
+
+    /** The maximum depth reached, in plies */
+    int seldepth = 0;
+
+    /** Time spent searching, in milliseconds */
+    std::int64_t time = 0;
+};
+
 /**
  * @brief Generic interface for a search algorithm
+ *
+ * A search may be run on one thread and stopped from another. It also stops
+ * on its own once the deadlines of its TimeManager, if any, have passed
  */
 class Search {
 public:
+    Search()
+        : game_history_(), info_channel_(), stop_(false), time_manager_() {}
+
+    Search(const Search& search)            = delete;
+    Search(Search&& search)                 = delete;
+    Search& operator=(const Search& search) = delete;
+    Search& operator=(Search&& search)      = delete;
+
     virtual ~Search() = default;
 
     /**
@@ -27,6 +78,121 @@ public:
      * @return The selected move, or a null move if the game is over
      */
     virtual std::uint32_t Run(const Position& position) = 0;
+
+    /**
+     * @brief Allow searching again after a call to Stop()
+     *
+     * @note This is not done by Run(), so that a stop requested just before
+     *       a search thread calls Run() is not lost
+     */
+    void ClearStop() noexcept {
+        stop_.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Set the positions that led to the next root position, so that
+     *        the search can recognize repetitions of them
+     *
+     * @param history The game so far, excluding the root position itself
+     */
+    void SetGameHistory(const GameHistory& history) {
+        game_history_ = history;
+    }
+
+    /**
+     * @brief Set where to report search progress
+     *
+     * @param channel Receives UCI "info" lines. May be nullptr, for no
+     *                reports
+     */
+    void SetInfoChannel(
+            std::shared_ptr<OutputStreamChannel> channel) noexcept {
+        info_channel_ = std::move(channel);
+    }
+
+    /**
+     * @brief Set the clock to search against
+     *
+     * @param time_manager Supplies the deadlines of each search. May be
+     *                     nullptr, for untimed searches
+     */
+    void SetTimeManager(
+            std::shared_ptr<const TimeManager> time_manager) noexcept {
+        time_manager_ = std::move(time_manager);
+    }
+
+    /**
+     * @brief Ask the current search to return as soon as possible. Searches
+     *        started afterwards return immediately until ClearStop() is
+     *        called
+     *
+     * @note Safe to call from any thread
+     */
+    void Stop() noexcept {
+        stop_.store(true, std::memory_order_relaxed);
+    }
+
+protected:
+    /**
+     * @brief Get the positions that led to the root position
+     *
+     * @return The history passed to SetGameHistory()
+     */
+    const GameHistory& GetGameHistory() const noexcept {
+        return game_history_;
+    }
+
+    /**
+     * @brief Check whether Stop() has been called. Cheap enough to poll at
+     *        every node
+     *
+     * @return True if the search should return
+     */
+    bool Stopped() const noexcept {
+        return stop_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Check whether the search must return. This reads the clock, so
+     *        search loops should call it only every so many nodes
+     *
+     * @return True if the hard deadline has passed
+     */
+    bool HardLimitReached() const noexcept {
+        return time_manager_ && time_manager_->HardLimitReached();
+    }
+
+    /**
+     * @brief Check whether the search should avoid starting new work
+     *
+     * @return True if the soft deadline has passed
+     */
+    bool SoftLimitReached() const noexcept {
+        return time_manager_ && time_manager_->SoftLimitReached();
+    }
+
+    void SendInfo(const SearchInfo& info) const;
+
+private:
+    /**
+     * The positions that led to the root position
+     */
+    GameHistory game_history_;
+
+    /**
+     * Receives UCI "info" lines
+     */
+    std::shared_ptr<OutputStreamChannel> info_channel_;
+
+    /**
+     * Set by Stop()
+     */
+    std::atomic<bool> stop_;
+
+    /**
+     * Supplies the search deadlines
+     */
+    std::shared_ptr<const TimeManager> time_manager_;
 };
 
 }  // namespace chess
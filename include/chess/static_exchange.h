@@ -7,6 +7,9 @@
 #ifndef CHESS_STATIC_EXCHANGE_H_
 #define CHESS_STATIC_EXCHANGE_H_
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 
 #include "chess/attacks.h"
@@ -51,10 +54,12 @@ inline Piece NextPiece(const Position& position,
         // and not target. When masked with attacks_from, this ensures we don't
         // pick up a bishop/queen/pawn between src and target since we are
         // not updating the occupied squares; we don't want to pick up the same
-        // attacker/defender twice along the line of attack
+        // attacker/defender twice along the line of attack. The target itself
+        // is on the ray too, and its occupant is not an attacker
 
-        const std::uint64_t ray = data_tables::kRay[target][src] ^
-                                  data_tables::kRaySegment[target][src];
+        const std::uint64_t ray = (data_tables::kRay[target][src] ^
+                                   data_tables::kRaySegment[target][src]) &
+                                  data_tables::kClearMask[target];
 
         const std::uint64_t attacks_from =
             ray & AttacksFrom<Piece::BISHOP>(src, occupied);
@@ -96,10 +101,12 @@ inline Piece NextPiece(const Position& position,
         // and not target. When masked with attacks_from, this ensures we don't
         // pick up a bishop/queen/pawn between src and target since we are
         // not updating the occupied squares; we don't want to pick up the same
-        // attacker/defender twice along the line of attack
+        // attacker/defender twice along the line of attack. The target itself
+        // is on the ray too, and its occupant is not an attacker
 
-        const std::uint64_t ray = data_tables::kRay[target][src] ^
-                                  data_tables::kRaySegment[target][src];
+        const std::uint64_t ray = (data_tables::kRay[target][src] ^
+                                   data_tables::kRaySegment[target][src]) &
+                                  data_tables::kClearMask[target];
 
         const std::uint64_t attacks_from =
             ray & AttacksFrom<Piece::BISHOP>(src, occupied);
@@ -132,10 +139,12 @@ inline Piece NextPiece(const Position& position,
         // and not target. When masked with attacks_from, this ensures we don't
         // pick up a rook/queen between src and target since we are
         // not updating the occupied squares; we don't want to pick up the same
-        // attacker/defender twice along the line of attack
+        // attacker/defender twice along the line of attack. The target itself
+        // is on the ray too, and its occupant is not an attacker
 
-        const std::uint64_t ray = data_tables::kRay[target][src] ^
-                                  data_tables::kRaySegment[target][src];
+        const std::uint64_t ray = (data_tables::kRay[target][src] ^
+                                   data_tables::kRaySegment[target][src]) &
+                                  data_tables::kClearMask[target];
 
         const std::uint64_t attacks_from =
             ray & AttacksFrom<Piece::ROOK>(src, occupied);
@@ -168,10 +177,12 @@ inline Piece NextPiece(const Position& position,
         // and not target. When masked with attacks_from, this ensures we don't
         // pick up a sliding piece between src and target since we are
         // not updating the occupied squares; we don't want to pick up the same
-        // attacker/defender twice along the line of attack
+        // attacker/defender twice along the line of attack. The target itself
+        // is on the ray too, and its occupant is not an attacker
 
-        const std::uint64_t ray = data_tables::kRay[target][src] ^
-                                  data_tables::kRaySegment[target][src];
+        const std::uint64_t ray = (data_tables::kRay[target][src] ^
+                                   data_tables::kRaySegment[target][src]) &
+                                  data_tables::kClearMask[target];
 
         const std::uint64_t attacks_from =
             ray & AttacksFrom<Piece::QUEEN>(src, occupied);
@@ -220,28 +231,70 @@ inline Piece NextPiece(const Position& position,
 
 }  // namespace detail
 
-#if 0
-// Edge case: enemy bishop attacking bishop attacking enemy pawn on square
-// Edge case: two pawns attacking the target
+/**
+ * @brief Compute the static exchange evaluation (SEE) of a square, i.e. the
+ *        material gained by a player from a sequence of captures on it
+ *
+ * The captures alternate between players, each capturing with its least
+ * valuable piece. Either side may stop the sequence when continuing would
+ * lose material
+ *
+ * @tparam P The player who captures first
+ *
+ * @param position[in] The position from which to compute SEE
+ * @param square[in]   The square over which to play out the capture sequence
+ *
+ * @return The material gained by \a P. This is never negative since \a P may
+ *         decline to initiate the exchange
+ */
 template <Player P>
 std::int16_t ComputeSee(const Position& position, Square square) noexcept {
     constexpr Player O = util::opponent<P>();
 
-    const auto& player = position.GetPlayerInfo<P>();
-
-    std::uint64_t occupied = position.Occupied();
+    const std::uint64_t occupied = position.Occupied();
 
-    std::uint64_t attackers = player.AttacksTo(square, occupied);
+    std::uint64_t attackers =
+        position.GetPlayerInfo<P>().AttacksTo(square, occupied);
 
     if (attackers == 0u) {
         // The player on move has no attackers, so we are done
         return 0;
     }
 
-    const auto& opponent = position.GetPlayerInfo<O>();
-    std::uint64_t defenders = opponent.AttacksTo(square, occupied);
+    std::uint64_t defenders =
+        position.GetPlayerInfo<O>().AttacksTo(square, occupied);
+
+    // gain[i] is the material balance, from the perspective of the player
+    // making the i-th capture, if the sequence stops after that capture
+
+    std::array<int, 32> gain;
+    gain[0] = data_tables::kPieceValue[position.PieceOn(square)];
+
+    Piece last = detail::NextPiece<P>(position, square, &attackers,
+                                      &defenders);
+
+    std::size_t depth = 1;
+
+    for (; depth < gain.size(); depth++) {
+        const Piece next = (depth % 2) == 1 ?
+            detail::NextPiece<O>(position, square, &defenders, &attackers) :
+            detail::NextPiece<P>(position, square, &attackers, &defenders);
+
+        if (next == Piece::EMPTY) break;
+
+        gain[depth] = data_tables::kPieceValue[last] - gain[depth-1];
+        last = next;
+    }
+
+    // Walk back through the sequence, letting each side stop capturing if
+    // that is better than continuing
+
+    while (--depth > 0) {
+        gain[depth-1] = -std::max(-gain[depth-1], gain[depth]);
+    }
+
+    return static_cast<std::int16_t>(std::max(0, gain[0]));
 }
-#endif
 
 }  // namespace chess
 
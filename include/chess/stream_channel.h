@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <cstdio>
 #include <functional>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -52,6 +53,9 @@ public:
 
 /**
  * @brief Sends engine output to clients
+ *
+ * The formatted Write() and operator<<() may be called from several threads
+ * at once; each message is written whole
  */
 class OutputStreamChannel {
 public:
@@ -87,6 +91,11 @@ private:
      */
     std::vector<char> message_;
 
+    /**
+     * Serializes writers, which share \ref message_
+     */
+    std::mutex mutex_;
+
     /**
      * Number of bytes to be written to the stream
      */
@@ -101,6 +110,8 @@ private:
  */
 template <typename... Ts>
 void OutputStreamChannel::Write(const char* format, Ts&&... args) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+
     if (size_ == 0) return;
 
     const int len = std::snprintf(message_.data(), message_.size(),
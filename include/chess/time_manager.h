@@ -0,0 +1,146 @@
+/**
+ *  \file   time_manager.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#ifndef CHESS_TIME_MANAGER_H_
+#define CHESS_TIME_MANAGER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "chess/chess.h"
+
+namespace chess {
+/**
+ * @brief Limits on a search, as given by the UCI "go" command. All times
+ *        are in milliseconds
+ */
+struct SearchLimits {
+    /** Black's increment per move */
+    std::optional<std::int64_t> binc;
+
+    /** Time left on black's clock */
+    std::optional<std::int64_t> btime;
+
+    /** Search no deeper than this many plies */
+    std::optional<int> depth;
+
+    /** Search until told to stop */
+    bool infinite = false;
+
+    /** Search for a mate in this many moves */
+    std::optional<int> mate;
+
+    /** The number of moves until the next time control */
+    std::optional<int> movestogo;
+
+    /** Search for exactly this long */
+    std::optional<std::int64_t> movetime;
+
+    /** Search no more than this many nodes */
+    std::optional<std::uint64_t> nodes;
+
+    /** Search in pondering mode, until "ponderhit" or "stop" */
+    bool ponder = false;
+
+    /** Only consider these root moves, in long algebraic notation */
+    std::vector<std::string> searchmoves;
+
+    /** White's increment per move */
+    std::optional<std::int64_t> winc;
+
+    /** Time left on white's clock */
+    std::optional<std::int64_t> wtime;
+};
+
+/**
+ * @brief Turns the clock state at the start of a search into a soft and a
+ *        hard deadline
+ *
+ * A search should not begin new work (e.g. another iteration) once the soft
+ * deadline has passed, and must return as soon as possible once the hard
+ * deadline has passed. The deadlines may be checked from any thread
+ */
+class TimeManager final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Time reserved per move for communication delays, in milliseconds
+     */
+    static constexpr std::int64_t kMoveOverhead = 30;
+
+    /**
+     * The number of moves the remaining time is divided among when the GUI
+     * does not say
+     */
+    static constexpr int kDefaultMovesToGo = 30;
+
+    /**
+     * The hard limit is at most this multiple of the soft limit
+     */
+    static constexpr int kHardLimitFactor = 4;
+
+    TimeManager();
+
+    TimeManager(const TimeManager& manager)            = delete;
+    TimeManager(TimeManager&& manager)                 = delete;
+    TimeManager& operator=(const TimeManager& manager) = delete;
+    TimeManager& operator=(TimeManager&& manager)      = delete;
+
+    ~TimeManager() = default;
+
+    std::int64_t Elapsed() const noexcept;
+
+    std::optional<std::int64_t> HardLimit() const noexcept;
+
+    bool HardLimitReached() const noexcept;
+
+    void PonderHit() noexcept;
+
+    std::optional<std::int64_t> SoftLimit() const noexcept;
+
+    bool SoftLimitReached() const noexcept;
+
+    void Start(const SearchLimits& limits, Player player) noexcept;
+
+private:
+    static Clock::rep Now() noexcept;
+
+    void SetDeadlines(Clock::rep start) noexcept;
+
+    /**
+     * The hard deadline, in clock ticks
+     */
+    std::atomic<Clock::rep> hard_deadline_;
+
+    /**
+     * Time allowed before the hard deadline, if any, in milliseconds
+     */
+    std::optional<std::int64_t> hard_limit_;
+
+    /**
+     * The soft deadline, in clock ticks
+     */
+    std::atomic<Clock::rep> soft_deadline_;
+
+    /**
+     * Time allowed before the soft deadline, if any, in milliseconds
+     */
+    std::optional<std::int64_t> soft_limit_;
+
+    /**
+     * The time at which the search started, in clock ticks
+     */
+    std::atomic<Clock::rep> start_;
+};
+
+}  // namespace chess
+
+#endif  // CHESS_TIME_MANAGER_H_
@@ -0,0 +1,124 @@
+/**
+ *  \file   transposition_table.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#ifndef CHESS_TRANSPOSITION_TABLE_H_
+#define CHESS_TRANSPOSITION_TABLE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace chess {
+/**
+ * @brief The type of bound a stored score represents
+ */
+enum class Bound : std::uint8_t {
+    kNone  = 0,
+    kUpper = 1,
+    kLower = 2,
+    kExact = 3
+};
+
+/**
+ * @brief A hash table shared by all search threads
+ *
+ * Each slot is a pair of 64-bit words: the packed entry data and the
+ * position key XOR'd with that data. A probe accepts a slot only if XOR'ing
+ * the two words back together reproduces the key, so a slot torn by two
+ * threads writing concurrently simply reads as a miss. This makes locking
+ * unnecessary
+ */
+class TranspositionTable final {
+public:
+    /**
+     * @brief The unpacked contents of a table slot
+     */
+    struct Entry {
+        /** The best (or refutation) move found, or 0 if none */
+        std::uint32_t move;
+
+        /** The search score */
+        std::int16_t score;
+
+        /** The depth searched to obtain this score */
+        std::int8_t depth;
+
+        /** The type of bound \ref score represents */
+        Bound bound;
+    };
+
+    /**
+     * The number of slots per bucket. Each bucket fills one cache line
+     */
+    static constexpr std::size_t kBucketSize = 4;
+
+    explicit TranspositionTable(std::size_t megabytes);
+
+    TranspositionTable(const TranspositionTable& table)            = delete;
+    TranspositionTable(TranspositionTable&& table)                 = delete;
+    TranspositionTable& operator=(const TranspositionTable& table) = delete;
+    TranspositionTable& operator=(TranspositionTable&& table)      = delete;
+
+    ~TranspositionTable() = default;
+
+    void Clear() noexcept;
+
+    int HashFull() const noexcept;
+
+    void NewSearch() noexcept;
+
+    bool Probe(std::uint64_t key, Entry* entry) const noexcept;
+
+    void Resize(std::size_t megabytes);
+
+    std::size_t Size() const noexcept;
+
+    void Store(std::uint64_t key, std::uint32_t move, int score, int depth,
+               Bound bound) noexcept;
+
+private:
+    /**
+     * A single slot. Both words are accessed with relaxed atomics; the XOR
+     * check, not memory ordering, is what detects a torn slot
+     */
+    struct Slot {
+        std::atomic<std::uint64_t> check;
+        std::atomic<std::uint64_t> data;
+    };
+
+    /**
+     * A group of slots sharing a cache line. A key may be stored in any
+     * slot of the bucket it hashes to
+     */
+    struct alignas(64) Bucket {
+        std::array<Slot, kBucketSize> slots;
+    };
+
+    static_assert(sizeof(Bucket) == 64);
+
+    Bucket& BucketFor(std::uint64_t key) const noexcept;
+
+    /**
+     * The table itself. The number of buckets is a power of two
+     */
+    std::unique_ptr<Bucket[]> buckets_;
+
+    /**
+     * \ref buckets_ size minus one, used to index by key
+     */
+    std::size_t mask_;
+
+    /**
+     * The current search generation, used to age out stale entries
+     */
+    std::uint8_t generation_;
+};
+
+}  // namespace chess
+
+#endif  // CHESS_TRANSPOSITION_TABLE_H_
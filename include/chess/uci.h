@@ -8,12 +8,15 @@
 #define CHESS_UCI_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "chess/command_dispatcher.h"
 #include "chess/data_buffer.h"
 #include "chess/logger.h"
 #include "chess/engine_interface.h"
 #include "chess/stream_channel.h"
+#include "chess/time_manager.h"
 
 namespace chess {
 /**
@@ -45,6 +48,8 @@ private:
     bool HandleQuitCommand(const std::vector<std::string>& );
     void HandleCommandUnknown(const ConstDataBuffer& buf);
 
+    SearchLimits ParseGoCommand(const std::vector<std::string>& args);
+
     /**
      * Handles user commands
      */
@@ -207,8 +207,58 @@ template <> constexpr int index<Player::kWhite>() noexcept {
  * @}
  */
 
-std::int8_t Lsb(std::uint64_t qword) noexcept;
-std::int8_t Msb(std::uint64_t qword) noexcept;
+/**
+ * @brief Count the number of bits set
+ *
+ * @param qword The word whose bits to count
+ *
+ * @return The number of bits set
+ */
+constexpr std::int8_t BitCount(std::uint64_t qword) noexcept {
+#if defined(__GNUC__) && defined(__POPCNT__)
+    return __builtin_popcountll(qword);
+#else
+    // Without POPCNT, __builtin_popcountll() becomes a library call, so sum
+    // the bits in parallel instead
+
+    qword = qword - ((qword >> 1) & 0x5555555555555555ull);
+    qword = (qword & 0x3333333333333333ull) +
+            ((qword >> 2) & 0x3333333333333333ull);
+    qword = (qword + (qword >> 4)) & 0x0f0f0f0f0f0f0f0full;
+
+    return (qword * 0x0101010101010101ull) >> 56;
+#endif
+}
+
+/**
+ * @brief Get the zero-indexed least significant bit (LSB) set
+ *
+ * @param qword The word whose LSB to compute
+ *
+ * @return The index of the least significant bit, or -1 if no bits are set
+ */
+constexpr std::int8_t Lsb(std::uint64_t qword) noexcept {
+#if defined(__GNUC__)
+    return qword == 0u ? -1 : __builtin_ctzll(qword);
+#else
+    return jfern::bitops::lsb(qword);
+#endif
+}
+
+/**
+ * @brief Get the zero-indexed most significant bit (MSB) set
+ *
+ * @param qword The word whose MSB to compute
+ *
+ * @return The index of the most significant bit, or -1 if no bits are set
+ */
+constexpr std::int8_t Msb(std::uint64_t qword) noexcept {
+#if defined(__GNUC__)
+    return qword == 0u ? -1 : 63 - __builtin_clzll(qword);
+#else
+    return jfern::bitops::msb(qword);
+#endif
+}
 
 /**
  * Get the opposing side
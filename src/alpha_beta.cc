@@ -0,0 +1,187 @@
+/**
+ *  \file   alpha_beta.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include "chess/alpha_beta.h"
+
+#include "chess/evaluate.h"
+
+namespace chess {
+/**
+ * @brief Constructor
+ *
+ * @param table  The transposition table, which may be shared with other
+ *               searches
+ * @param logger Logs search progress
+ */
+AlphaBeta::AlphaBeta(std::shared_ptr<TranspositionTable> table,
+                     std::shared_ptr<Logger> logger)
+    : aborted_(false),
+      history_(2),
+      killers_(kMaxSearchPly),
+      logger_(logger),
+      max_depth_(kMaxSearchPly / 2),
+      max_nodes_(std::numeric_limits<std::uint64_t>::max()),
+      nodes_(0),
+      path_(),
+      pv_(kMaxSearchPly),
+      pv_length_(),
+      root_pv_(),
+      root_depth_(0),
+      root_score_(0),
+      seldepth_(0),
+      table_(table) {
+}
+
+/**
+ * @brief Get the depth reached by the last search
+ *
+ * @return The depth of the last completed iteration
+ */
+int AlphaBeta::Depth() const noexcept {
+    return root_depth_;
+}
+
+/**
+ * @brief Get the number of nodes visited by the last search
+ *
+ * @return The node count, including quiescence nodes
+ */
+std::uint64_t AlphaBeta::Nodes() const noexcept {
+    return nodes_;
+}
+
+/**
+ * @brief Get the principal variation found by the last search
+ *
+ * @return The expected line of play, starting with the best move
+ */
+std::vector<std::uint32_t> AlphaBeta::PrincipalVariation() const {
+    return root_pv_;
+}
+
+/**
+ * @see Search::Run()
+ */
+std::uint32_t AlphaBeta::Run(const Position& position) {
+    nodes_ = 0;
+    root_depth_ = 0;
+    root_score_ = 0;
+    root_pv_.clear();
+    seldepth_ = 0;
+    aborted_ = false;
+
+    for (auto& player : history_) {
+        for (auto& from : player) from.fill(0);
+    }
+
+    for (auto& killers : killers_) killers.fill(kNullMove);
+
+    if (GameResult(position) != Result::kGameNotOver) {
+        return kNullMove;
+    }
+
+    table_->NewSearch();
+
+    path_ = GetGameHistory();
+
+    Position pos(position);
+
+    return pos.ToMove() == Player::kWhite ? Iterate<Player::kWhite>(&pos) :
+                                            Iterate<Player::kBlack>(&pos);
+}
+
+/**
+ * @brief Get the score of the last search
+ *
+ * @return The score of the last completed iteration, from the perspective of
+ *         the player to move at the root
+ */
+int AlphaBeta::Score() const noexcept {
+    return root_score_;
+}
+
+/**
+ * @brief Limit the search depth
+ *
+ * @param depth The maximum number of plies to search, excluding extensions
+ */
+void AlphaBeta::SetMaxDepth(int depth) noexcept {
+    max_depth_ = std::clamp(depth, 1, kMaxSearchPly / 2);
+}
+
+/**
+ * @brief Limit the number of nodes searched
+ *
+ * @param nodes Abort the search after visiting this many nodes
+ */
+void AlphaBeta::SetMaxNodes(std::uint64_t nodes) noexcept {
+    max_nodes_ = nodes;
+}
+
+/**
+ * @brief Convert a score read from the transposition table to one relative
+ *        to the root
+ *
+ * @param score The stored score
+ * @param ply   Distance from the root
+ *
+ * @return The score relative to the root
+ */
+int AlphaBeta::FromTable(int score, int ply) noexcept {
+    if (score >=  kMateScore - kMaxSearchPly) return score - ply;
+    if (score <= -kMateScore + kMaxSearchPly) return score + ply;
+    return score;
+}
+
+/**
+ * @brief Count a node and check whether the search must stop
+ *
+ * @return True if a search limit has been reached or Stop() was called
+ */
+bool AlphaBeta::StopRequested() noexcept {
+    ++nodes_;
+
+    if (nodes_ >= max_nodes_ || Stopped() ||
+        ((nodes_ & (kTimeCheckInterval-1)) == 0u && HardLimitReached())) {
+        aborted_ = true;
+    }
+
+    return aborted_;
+}
+
+/**
+ * @brief Convert a score relative to the root into one relative to the
+ *        current node, for storing in the transposition table. This lets
+ *        mate scores be reused at other distances from the root
+ *
+ * @param score The score relative to the root
+ * @param ply   Distance from the root
+ *
+ * @return The score to store
+ */
+int AlphaBeta::ToTable(int score, int ply) noexcept {
+    if (score >=  kMateScore - kMaxSearchPly) return score + ply;
+    if (score <= -kMateScore + kMaxSearchPly) return score - ply;
+    return score;
+}
+
+/**
+ * @brief Prepend a move to the principal variation from the next ply
+ *
+ * @param ply  Distance from the root
+ * @param move The best move at \a ply
+ */
+void AlphaBeta::UpdatePv(int ply, std::uint32_t move) noexcept {
+    pv_[ply][ply] = move;
+
+    for (int i = ply+1; i < pv_length_[ply+1]; i++) {
+        pv_[ply][i] = pv_[ply+1][i];
+    }
+
+    pv_length_[ply] = std::max(ply+1, pv_length_[ply+1]);
+}
+
+}  // namespace chess
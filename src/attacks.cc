@@ -0,0 +1,95 @@
+/**
+ *  \file   attacks.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include "chess/attacks.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace chess {
+namespace detail {
+namespace {
+/**
+ * @brief Fill one PEXT database by permuting the entries of the existing
+ *        magic database, which is much cheaper than computing each attack
+ *        set again
+ *
+ * @param[in]  masks   The relevant occupancy of each square
+ * @param[in]  offsets Where each square's entries begin
+ * @param[in]  magics  The magic multiplier of each square
+ * @param[in]  shifts  The magic shift of each square
+ * @param[in]  magic   The magic "attacks from" database
+ * @param[out] table   The database to fill
+ */
+template <typename Magic, typename Table>
+void FillTable(const std::array<std::uint64_t,64>& masks,
+               const std::array<std::uint32_t,64>& offsets,
+               const std::array<std::uint64_t,64>& magics,
+               const std::array<int,64>& shifts,
+               const Magic& magic,
+               Table* table) noexcept {
+    for (int square = 0; square < 64; square++) {
+        const std::uint64_t mask = masks[square];
+
+        // Visit every subset of the mask (the "carry rippler"). Subsets are
+        // produced in increasing order of their PEXT index
+
+        std::size_t index = offsets[square];
+        std::uint64_t subset = 0;
+        do {
+            (*table)[index++] = magic[offsets[square] +
+                ((subset * magics[square]) >> shifts[square])];
+
+            subset = (subset - mask) & mask;
+        } while (subset != 0u);
+    }
+}
+
+/**
+ * @brief Decide whether to use PEXT and if so, build its databases. Runs
+ *        during static initialization. With runtime data tables the magic
+ *        databases are filled first, at a higher init priority
+ *
+ * @return True if PEXT is to be used
+ */
+bool InitPext() noexcept {
+#if CHESS_SLIDING_ATTACKS==CHESS_ATTACKS_MAGIC
+    return false;
+#else
+#if CHESS_SLIDING_ATTACKS==CHESS_ATTACKS_AUTO
+#if defined(__x86_64__) && defined(__GNUC__)
+    if (!__builtin_cpu_supports("bmi2")) return false;
+#else
+    return false;
+#endif
+#endif
+    FillTable(data_tables::kBishopAttacksMask,
+              data_tables::kBishopOffsets,
+              data_tables::kDiagMagics,
+              data_tables::kBishopDbShifts,
+              data_tables::kBishopAttacks,
+              &pext_attacks.bishop);
+
+    FillTable(data_tables::kRookAttacksMask,
+              data_tables::kRookOffsets,
+              data_tables::kRookMagics,
+              data_tables::kRookDbShifts,
+              data_tables::kRookAttacks,
+              &pext_attacks.rook);
+
+    return true;
+#endif
+}
+
+}  // namespace
+
+PextAttacks pext_attacks;
+
+bool use_pext = InitPext();
+
+}  // namespace detail
+}  // namespace chess
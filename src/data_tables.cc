@@ -0,0 +1,311 @@
+/**
+ *  \file   data_tables.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include "chess/data_tables.h"
+
+#if CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "chess/util.h"
+
+namespace chess {
+namespace data_tables {
+namespace internal {
+namespace {
+/**
+ * The arena is aligned to this so it can be backed by one transparent huge
+ * page (it is a bit under 2 MiB)
+ */
+constexpr std::size_t kHugePageSize = std::size_t(1) << 21;
+
+static_assert(sizeof(TableArena) <= kHugePageSize);
+
+/**
+ * The generators in data_tables_internal.h are written for compile time and
+ * are far too slow to run at startup. These compute the same tables from the
+ * small direction masks, which remain constexpr
+ *
+ * @{
+ */
+
+/**
+ * @brief Compute the squares attacked by a bishop
+ *
+ * @param[in] square   The square the bishop is on
+ * @param[in] occupied The squares occupied by all other pieces
+ *
+ * @return The squares attacked
+ */
+std::uint64_t BishopAttacks(int square, std::uint64_t occupied) noexcept {
+    std::uint64_t attacks = kBishopRangeMask[square] ^ kSetMask[square];
+
+    std::int8_t blocker = util::Lsb(occupied & kNorthEastMask[square]);
+    if (blocker != -1) attacks ^= kNorthEastMask[blocker];
+
+    blocker = util::Msb(occupied & kSouthEastMask[square]);
+    if (blocker != -1) attacks ^= kSouthEastMask[blocker];
+
+    blocker = util::Lsb(occupied & kNorthWestMask[square]);
+    if (blocker != -1) attacks ^= kNorthWestMask[blocker];
+
+    blocker = util::Msb(occupied & kSouthWestMask[square]);
+    if (blocker != -1) attacks ^= kSouthWestMask[blocker];
+
+    return attacks;
+}
+
+/**
+ * @brief Compute the squares attacked by a rook
+ *
+ * @param[in] square   The square the rook is on
+ * @param[in] occupied The squares occupied by all other pieces
+ *
+ * @return The squares attacked
+ */
+std::uint64_t RookAttacks(int square, std::uint64_t occupied) noexcept {
+    std::uint64_t attacks = kRookRangeMask[square] ^ kSetMask[square];
+
+    std::int8_t blocker = util::Lsb(occupied & kNorthMask[square]);
+    if (blocker != -1) attacks ^= kNorthMask[blocker];
+
+    blocker = util::Lsb(occupied & kWestMask[square]);
+    if (blocker != -1) attacks ^= kWestMask[blocker];
+
+    blocker = util::Msb(occupied & kEastMask[square]);
+    if (blocker != -1) attacks ^= kEastMask[blocker];
+
+    blocker = util::Msb(occupied & kSouthMask[square]);
+    if (blocker != -1) attacks ^= kSouthMask[blocker];
+
+    return attacks;
+}
+
+/**
+ * @brief Get the direction along which two squares lie
+ *
+ * @param[in] square1 The 1st square
+ * @param[in] square2 The 2nd square
+ *
+ * @return The direction shared by these squares
+ */
+Direction SquareDirection(int square1, int square2) noexcept {
+    if (square1 == square2)                    return Direction::kNone;
+    if (kH1A8_64[square1] == kH1A8_64[square2]) return Direction::kAlongH1A8;
+    if (kRanks64[square1] == kRanks64[square2]) return Direction::kAlongRank;
+    if (kA1H8_64[square1] == kA1H8_64[square2]) return Direction::kAlongA1H8;
+    if (kFiles64[square1] == kFiles64[square2]) return Direction::kAlongFile;
+
+    return Direction::kNone;
+}
+
+/**
+ * @brief Get the line (rank, file or diagonal) through two squares
+ *
+ * @param[in] square1 The 1st square
+ * @param[in] square2 The 2nd square
+ *
+ * @return The line, or zero if the squares do not connect
+ */
+std::uint64_t Line(int square1, int square2) noexcept {
+    switch (SquareDirection(square1, square2)) {
+        case Direction::kAlongH1A8: return kH1A8_64[square1];
+        case Direction::kAlongRank: return kRanks64[square1];
+        case Direction::kAlongA1H8: return kA1H8_64[square1];
+        case Direction::kAlongFile: return kFiles64[square1];
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Get the ray from one square through another
+ *
+ * @param[in] origin The ray's origin square
+ * @param[in] square The square through which to extend the ray
+ *
+ * @return The ray, including \a origin, or zero if the squares do not connect
+ */
+std::uint64_t Ray(int origin, int square) noexcept {
+    const bool up = origin < square;
+
+    switch (SquareDirection(origin, square)) {
+        case Direction::kAlongH1A8:
+            return kSetMask[origin] |
+                (up ? kNorthWestMask[origin] : kSouthEastMask[origin]);
+        case Direction::kAlongFile:
+            return kSetMask[origin] |
+                (up ? kNorthMask[origin] : kSouthMask[origin]);
+        case Direction::kAlongA1H8:
+            return kSetMask[origin] |
+                (up ? kNorthEastMask[origin] : kSouthWestMask[origin]);
+        case Direction::kAlongRank:
+            return kSetMask[origin] |
+                (up ? kWestMask[origin] : kEastMask[origin]);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Get the squares strictly between two squares
+ *
+ * @param[in] square1 The 1st square
+ * @param[in] square2 The 2nd square
+ *
+ * @return The squares in between, or zero if the squares do not connect
+ */
+std::uint64_t Segment(int square1, int square2) noexcept {
+    return (kNorthEastMask[square1] & kSouthWestMask[square2]) |
+           (kNorthEastMask[square2] & kSouthWestMask[square1]) |
+           (kNorthMask[square1]     & kSouthMask[square2])     |
+           (kNorthMask[square2]     & kSouthMask[square1])     |
+           (kNorthWestMask[square1] & kSouthEastMask[square2]) |
+           (kNorthWestMask[square2] & kSouthEastMask[square1]) |
+           (kEastMask[square1]      & kWestMask[square2])      |
+           (kWestMask[square1]      & kEastMask[square2]);
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @brief Fill one sliding piece "attacks from" database along with its
+ *        mobility database
+ *
+ * @details A slider's attacks along one of its two lines do not depend on the
+ *          occupancy of the other, so each line's attacks are computed once
+ *          per subset and then combined
+ *
+ * @param[in]  masks    The relevant occupancy of each square
+ * @param[in]  lines    For each square, one of the two lines a piece on it
+ *                      slides along
+ * @param[in]  magics   The magic multiplier of each square
+ * @param[in]  shifts   The magic shift of each square
+ * @param[in]  offsets  Where each square's entries begin
+ * @param[in]  attacks  Computes attacks from a square, given the occupancy
+ * @param[out] table    The attacks database to fill
+ * @param[out] mobility The mobility database to fill
+ */
+template <typename Attacks, typename Table, typename Mobility>
+void FillSliding(const std::array<std::uint64_t,64>& masks,
+                 const std::array<std::uint64_t,64>& lines,
+                 const std::array<std::uint64_t,64>& magics,
+                 const std::array<int,64>& shifts,
+                 const std::array<std::uint32_t,64>& offsets,
+                 Attacks&& attacks,
+                 Table* table,
+                 Mobility* mobility) noexcept {
+    // At most 6 relevant squares lie on any one line
+    std::uint64_t subsets[64], line_attacks[64];
+    std::int8_t line_mobility[64];
+
+    for (int square = 0; square < 64; square++) {
+        const std::uint64_t line = lines[square];
+        const std::uint64_t mask1 = masks[square] & line;
+        const std::uint64_t mask2 = masks[square] & ~line;
+
+        // Visit every subset of each mask (the "carry rippler")
+
+        std::size_t n = 0;
+        std::uint64_t subset = 0;
+        do {
+            subsets[n] = subset;
+            line_attacks[n] = attacks(square, subset) & ~line;
+            line_mobility[n] = util::BitCount(line_attacks[n]);
+            n++;
+
+            subset = (subset - mask2) & mask2;
+        } while (subset != 0u);
+
+        subset = 0;
+        do {
+            const std::uint64_t squares = attacks(square, subset) & line;
+            const std::int8_t count = util::BitCount(squares);
+
+            for (std::size_t i = 0; i < n; i++) {
+                const std::uint32_t index = offsets[square] +
+                    (((subset | subsets[i]) * magics[square]) >>
+                        shifts[square]);
+
+                (*table)[index]    = squares | line_attacks[i];
+                (*mobility)[index] = count + line_mobility[i];
+            }
+
+            subset = (subset - mask1) & mask1;
+        } while (subset != 0u);
+    }
+}
+
+/**
+ * Fills in the arena before any other static initializer runs (on compilers
+ * that support init_priority)
+ */
+struct ArenaInitializer {
+    ArenaInitializer() noexcept {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        // Best effort; the tables work the same on regular pages
+        madvise(&table_arena, sizeof(table_arena), MADV_HUGEPAGE);
+#endif
+        InitTableArena();
+    }
+};
+
+#if defined(__GNUC__)
+__attribute__((init_priority(101)))
+#endif
+const ArenaInitializer arena_initializer;
+
+}  // namespace
+
+alignas(kHugePageSize) TableArena table_arena;
+
+void InitTableArena() noexcept {
+    FillSliding(kRookAttacksMask, kFiles64, kRookMagics, kRookDbShifts,
+                kRookOffsets,
+                RookAttacks,
+                &table_arena.rook_attacks,
+                &table_arena.rook_mobility);
+
+    FillSliding(kBishopAttacksMask, kA1H8_64, kDiagMagics, kBishopDbShifts,
+                kBishopOffsets,
+                BishopAttacks,
+                &table_arena.bishop_attacks,
+                &table_arena.bishop_mobility);
+
+    for (int square1 = 0; square1 < 64; square1++) {
+        for (int square2 = 0; square2 < 64; square2++) {
+            table_arena.ray_segment[square1][square2] =
+                Segment(square1, square2);
+            table_arena.ray_extend[square1][square2] =
+                Line(square1, square2);
+            table_arena.ray[square1][square2] =
+                Ray(square1, square2);
+            table_arena.directions[square1][square2] =
+                SquareDirection(square1, square2);
+        }
+    }
+
+    for (std::size_t i = 0; i < table_arena.lsb.size(); i++) {
+        const auto word = static_cast<std::uint16_t>(i);
+
+        table_arena.lsb[i] = util::Lsb(word);
+        table_arena.msb[i] = util::Msb(word);
+        table_arena.pop[i] = util::BitCount(word);
+    }
+}
+
+}  // namespace internal
+}  // namespace data_tables
+}  // namespace chess
+
+#endif  // CHESS_DATA_TABLES==CHESS_TABLES_RUNTIME
@@ -10,6 +10,8 @@
 #include <algorithm>
 #include <cstdint>
 #include <iterator>
+#include <limits>
+#include <system_error>
 
 #include "superstring/superstring.h"
 
@@ -22,15 +24,27 @@ namespace chess {
  */
 Engine::Engine(std::shared_ptr<OutputStreamChannel> channel,
                std::shared_ptr<Logger> logger)
-    : channel_(channel),
+    : bestmove_time_(),
+      channel_(channel),
       debug_mode_(false),
+      game_history_(),
       is_running_(false),
       logger_(logger),
       master_(),
-      mem_pool_() {
+      mem_pool_(),
+      mtcs_(),
+      search_thread_(),
+      time_manager_(std::make_shared<TimeManager>()) {
     master_.Reset();
 }
 
+/**
+ * @brief Destructor. Stops any search in progress
+ */
+Engine::~Engine() {
+    Stop();
+}
+
 /**
  * Handler for the UCI "uci" command
  */
@@ -86,6 +100,9 @@ void Engine::UciNewGame() noexcept {
 
     logger_->Write("Resetting for a new game.\n");
     master_.Reset();
+    game_history_.Clear();
+
+    if (mtcs_) mtcs_->Clear();
 }
 
 /**
@@ -124,6 +141,7 @@ bool Engine::Position(const std::vector<std::string>& args) noexcept {
     }
 
     chess::Position backup(master_);
+    const GameHistory history_backup(game_history_);
 
     const Position::FenError error = master_.Reset(fen);
     if (error != Position::FenError::kSuccess) {
@@ -133,6 +151,8 @@ bool Engine::Position(const std::vector<std::string>& args) noexcept {
         return false;
     }
 
+    game_history_.Clear();
+
     // Play out the supplied move sequence
 
     if (moves_start != args.end()) {
@@ -143,14 +163,23 @@ bool Engine::Position(const std::vector<std::string>& args) noexcept {
             if (move == kNullMove) {
                 logger_->Write("Bad move in sequence '%s'\n", iter->c_str());
                 master_ = backup;  // restore to original
+                game_history_ = history_backup;
                 return false;
             }
 
+            game_history_.Push(master_.Hash());
+
+            Position::UndoInfo undo;
+
             if (master_.ToMove() == Player::kWhite) {
-                master_.MakeMove<Player::kWhite>(move, 0);
+                master_.MakeMove<Player::kWhite>(move, &undo);
             } else {
-                master_.MakeMove<Player::kBlack>(move, 0);
+                master_.MakeMove<Player::kBlack>(move, &undo);
             }
+
+            // Positions before an irreversible move cannot occur again
+
+            if (master_.HalfMoveNumber() == 0) game_history_.Clear();
         }
     }
 
@@ -158,39 +187,127 @@ bool Engine::Position(const std::vector<std::string>& args) noexcept {
 }
 
 /**
- * @brief Handler for the UCI "go" command
+ * @brief Handler for the UCI "go" command. Starts a search on the search
+ *        thread and returns immediately
+ *
+ * @param limits The search parameters
  */
-void Engine::Go() noexcept {
+void Engine::Go(const SearchLimits& limits) noexcept {
+    Stop();
+
+    if (!mtcs_) {
+        logger_->Write("Node size = %zu\n", sizeof(Mtcs::Node));
+
+        auto mem_log = std::make_shared<Logger>("MemoryPool", channel_);
+
+        mem_pool_ = std::make_shared<MemoryPool<Mtcs::Node>>(100000000,
+                                                             mem_log);
+
+        mtcs_ = std::make_shared<Mtcs>(
+            mem_pool_, std::make_shared<Logger>("MTCS", channel_));
+        mtcs_->SetThreads(std::thread::hardware_concurrency());
+        mtcs_->SetTimeManager(time_manager_);
+        mtcs_->SetInfoChannel(channel_);
+    }
+
+    time_manager_->Start(limits, master_.ToMove());
+
+    // MCTS has no notion of depth, so only the node limit and the clock
+    // bound it. A timed search runs until a deadline passes or it is
+    // stopped
+
+    const bool timed = limits.infinite || limits.ponder ||
+                       time_manager_->HardLimit().has_value();
+
+    if (limits.nodes) {
+        mtcs_->SetIterations(*limits.nodes);
+    } else if (timed) {
+        mtcs_->SetIterations(std::numeric_limits<std::size_t>::max());
+    } else {
+        mtcs_->SetIterations(Mtcs::kDefaultIterations);
+    }
+
+    if (limits.depth || limits.mate || !limits.searchmoves.empty()) {
+        logger_->Write("Ignoring unsupported depth/mate/searchmoves limits\n");
+    }
+
+    const std::int64_t soft = time_manager_->SoftLimit().value_or(-1);
+    const std::int64_t hard = time_manager_->HardLimit().value_or(-1);
+
+    logger_->Write("Time limits: soft = %lld ms, hard = %lld ms\n",
+                   static_cast<long long>(soft),
+                   static_cast<long long>(hard));
+
+    mtcs_->SetGameHistory(game_history_);
+    mtcs_->ClearStop();
+
     is_running_ = true;
     logger_->Write("Search has started.\n");
 
-    std::uint32_t bestmove;
+    auto search = [this]() {
+        std::uint32_t bestmove;
 
-    master_.ToMove() == Player::kWhite ? Search<Player::kWhite>(&bestmove) :
-                                         Search<Player::kBlack>(&bestmove);
+        master_.ToMove() == Player::kWhite ?
+            Search<Player::kWhite>(&bestmove) :
+            Search<Player::kBlack>(&bestmove);
 
-    if (bestmove != 0u) {
-        const std::string move = util::ToLongAlgebraic(bestmove);
-        channel_->Write("bestmove %s\n", move.c_str());
-        channel_->Flush();
+        if (bestmove != 0u) {
+            const std::string move = util::ToLongAlgebraic(bestmove);
+            channel_->Write("bestmove %s\n", move.c_str());
+            channel_->Flush();
+        }
+
+        bestmove_time_ = std::chrono::steady_clock::now();
+        is_running_ = false;
+    };
+
+    try {
+        search_thread_ = std::thread(search);
+    } catch (const std::system_error& error) {
+        logger_->Write("Unable to start search thread: %s\n", error.what());
+        is_running_ = false;
     }
 }
 
 /**
- * @brief Handler for the UCI "stop" command
+ * @brief Handler for the UCI "stop" command. Returns once the search thread
+ *        has sent "bestmove"
  */
 void Engine::Stop() noexcept {
-    if (is_running_) {
-        logger_->Write("Search was stopped.\n");
+    if (!search_thread_.joinable()) return;
+
+    if (!is_running_) {
+        search_thread_.join();
+        return;
     }
 
-    is_running_ = false;
+    const auto start = std::chrono::steady_clock::now();
+
+    mtcs_->Stop();
+    search_thread_.join();
+
+    // If the search finished on its own just before being stopped, the
+    // latency is zero
+
+    const auto latency = std::max<long long>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            bestmove_time_ - start).count(), 0);
+
+    logger_->Write("Search was stopped. Latency to bestmove = %lld us\n",
+                   latency);
+
+    if (debug_mode_) {
+        channel_->Write("info string stop latency %lld us\n", latency);
+        channel_->Flush();
+    }
 }
 
 /**
  * @brief Handler for the UCI "ponderhit" command
  */
 void Engine::PonderHit() noexcept {
+    logger_->Write("Received ponderhit.\n");
+    time_manager_->PonderHit();
 }
 
 }  // namespace chess
@@ -16,8 +16,7 @@ namespace chess {
 Logger::Logger(const std::string& name,
                std::shared_ptr<OutputStreamChannel> channel)
     : channel_(channel),
-      name_(name),
-      prefix_buffer_(name.size() + 200, '\0') {
+      name_(name) {
 }
 
 /**
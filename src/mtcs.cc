@@ -6,75 +6,111 @@
 
 #include "chess/mtcs.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstddef>
 #include <cmath>
+#include <functional>
 #include <random>
+#include <thread>
+#include <vector>
 
 #include "chess/evaluate.h"
 #include "chess/movegen.h"
 
 namespace chess {
+namespace {
 /**
- * @brief Random number generator helper
- *
- * Generates numbers in the interval [0, N], where N is user specified
+ * @brief The xoshiro256** pseudorandom number generator. Small and fast, with
+ *        good statistical quality; not suitable for cryptography
  */
-class RandomInt final {
+class Xoshiro256 final {
 public:
     /**
-     * Constructor
+     * @brief Constructor
      *
-     * @param max Maximum value that should be generated
+     * @param seed Expanded into the initial state with SplitMix64, which
+     *             guarantees the state is not all zeros
      */
-    explicit RandomInt(std::size_t max)
-        : dist_(), gen_(), max_(max) {
-        dist_ = std::make_shared<std::uniform_int_distribution<>>(
-                    0, max_);
+    explicit Xoshiro256(std::uint64_t seed) : state_() {
+        for (auto& word : state_) {
+            seed += 0x9e3779b97f4a7c15;
+
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
 
-        std::random_device dev;
-        gen_ = std::make_shared<std::mt19937>(dev());
+            word = z ^ (z >> 31);
+        }
     }
 
     /**
      * @brief Get the next random value
      *
-     * @return An integer in the range [0, N] where N is user specified
+     * @return 64 random bits
      */
-    std::size_t next() {
-        return dist_->operator()(*gen_);
+    std::uint64_t Next() noexcept {
+        const std::uint64_t result = Rotate(state_[1] * 5, 7) * 9;
+        const std::uint64_t t = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+
+        state_[2] ^= t;
+        state_[3] = Rotate(state_[3], 45);
+
+        return result;
     }
 
 private:
-    /**
-     * The actual number generator
-     */
-    std::shared_ptr<std::uniform_int_distribution<>>
-        dist_;
-    
-    /**
-     * The random engine
-     */
-    std::shared_ptr<std::mt19937> gen_;
+    static constexpr std::uint64_t Rotate(std::uint64_t x, int k) noexcept {
+        return (x << k) | (x >> (64 - k));
+    }
 
     /**
-     * Maximum value to be generated, inclusive
+     * The generator state
      */
-    std::size_t max_;
+    std::array<std::uint64_t, 4> state_;
 };
 
+}  // namespace
+
 /**
- * @brief Generate a random integer
+ * @brief Generate a random integer. Each thread has its own generator
  *
- * @param max_value Generate a value between [0, max_value)
+ * The range reduction is Lemire's multiply-and-shift method, which rejects
+ * the few values that would otherwise bias the result, so no division is
+ * needed except in rare cases
+ *
+ * @param max_value Generate a value between [0, max_value). Must be greater
+ *                  than zero and fit in 32 bits
  *
  * @return The random value
  */
 std::size_t random(std::size_t max_value) {
-    static RandomInt generator(kMaxMoves);
+    thread_local Xoshiro256 generator(
+        (std::uint64_t(std::random_device()()) << 32) ^
+            std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    const auto range = static_cast<std::uint32_t>(max_value);
 
-    return generator.next() % max_value;
+    std::uint64_t product =
+        (generator.Next() >> 32) * std::uint64_t(range);
+
+    if (static_cast<std::uint32_t>(product) < range) {
+        const std::uint32_t threshold = -range % range;
+
+        while (static_cast<std::uint32_t>(product) < threshold) {
+            product = (generator.Next() >> 32) * std::uint64_t(range);
+        }
+    }
+
+    return static_cast<std::size_t>(product >> 32);
 }
 
 /**
@@ -82,11 +118,12 @@ std::size_t random(std::size_t max_value) {
  */
 Mtcs::Node::Node()
     : childs_(nullptr),
-      hash_(0x0),
-      next_(nullptr),
-      num_childs_(0u),
+      move_(kNullMove),
       sum_(0),
-      visits_(0u) {
+      visits_(0u),
+      expanded_(false),
+      locked_(false),
+      num_childs_(0u) {
 }
 
 /**
@@ -95,7 +132,19 @@ Mtcs::Node::Node()
  * @return The average value
  */
 double Mtcs::Node::Average() const {
-    return visits_ == 0u ? kInfinityF64 : double(sum_) / visits_;
+    const std::uint32_t visits = visits_.load(std::memory_order_relaxed);
+    const std::int32_t sum = sum_.load(std::memory_order_relaxed);
+
+    return visits == 0u ? kInfinityF64 : double(sum) / visits;
+}
+
+/**
+ * @brief Get the move leading to this node
+ *
+ * @return The move played from the parent node, or kNullMove at the root
+ */
+std::uint32_t Mtcs::Node::Move() const noexcept {
+    return move_;
 }
 
 /**
@@ -104,26 +153,23 @@ double Mtcs::Node::Average() const {
  * @return The number of visits
  */
 std::uint32_t Mtcs::Node::Visits() const {
-    return visits_;
+    return visits_.load(std::memory_order_relaxed);
 }
 
 /**
- * @brief Get the last node in the list of childs
- *
- * @return Node* The last node in the list or nullptr if the list is empty
+ * @brief Acquire exclusive access for expanding this node
  */
-auto Mtcs::Node::End() -> Node* {
-    if (!childs_) {
-        return nullptr;
-    }
-
-    Node* node = childs_;
-
-    while (node->next_ != nullptr) {
-        node = node->next_;
+void Mtcs::Node::Lock() noexcept {
+    while (locked_.exchange(true, std::memory_order_acquire)) {
+        std::this_thread::yield();
     }
+}
 
-    return node;
+/**
+ * @brief Release the lock taken by Lock()
+ */
+void Mtcs::Node::Unlock() noexcept {
+    locked_.store(false, std::memory_order_release);
 }
 
 /**
@@ -134,40 +180,315 @@ auto Mtcs::Node::End() -> Node* {
  */
 Mtcs::Mtcs(std::shared_ptr<MemoryPool<Node>> pool,
            std::shared_ptr<Logger> logger)
-    : childs_(),
+    : max_iterations_(kDefaultIterations),
+      n_threads_(1),
       iterations_(0),
       logger_(logger),
-      node_pool_(pool) {
+      node_pool_(pool),
+      root_(),
+      root_node_(),
+      root_visits_(0),
+      seldepth_(0) {
 }
 
 /**
- * @see Search::Run()
+ * @brief Discard the search tree, returning all nodes to the pool
+ */
+void Mtcs::Clear() {
+    root_node_.childs_ = nullptr;
+    root_node_.num_childs_ = 0;
+    root_node_.expanded_ = false;
+    root_visits_ = 0;
+
+    node_pool_->Free();
+}
+
+/**
+ * @brief Get the number of iterations run by the last search
+ *
+ * @return The number of playouts started from the root
+ */
+std::size_t Mtcs::Iterations() const noexcept {
+    return iterations_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Describe the progress of the current search. The principal
+ *        variation follows the most visited child at each ply
+ *
+ * @param elapsed Time spent searching so far, in milliseconds
+ *
+ * @return The search progress
+ */
+SearchInfo Mtcs::Info(std::int64_t elapsed) const {
+    SearchInfo info;
+
+    const Node* node = &root_node_;
+
+    while (node->expanded_.load(std::memory_order_acquire) &&
+           info.pv.size() < kMaxPly) {
+        const Node* const childs = node->childs_;
+        const Node* const end = childs + node->num_childs_;
+
+        const Node* best = std::max_element(childs, end,
+                                            [](const Node& a, const Node& b) {
+                                                return a.Visits() < b.Visits();
+                                            });
+
+        if (best == end || best->Visits() == 0u) break;
+
+        // Convert the root player's expected outcome to centipawns, on the
+        // usual logistic scale
+
+        if (node == &root_node_) {
+            const double q = std::clamp(-best->Average(), -0.999, 0.999);
+            info.score = static_cast<int>(
+                std::round(400.0 * std::log10((1.0 + q) / (1.0 - q))));
+        }
+
+        info.pv.push_back(best->move_);
+        node = best;
+    }
+
+    info.depth    = static_cast<int>(info.pv.size());
+    info.hashfull = node_pool_->Size() == 0u ? 1000 :
+        static_cast<int>(node_pool_->InUse() * 1000 / node_pool_->Size());
+    info.nodes    = iterations_.load(std::memory_order_relaxed);
+    info.seldepth = static_cast<int>(seldepth_.load());
+    info.time     = elapsed;
+
+    return info;
+}
+
+/**
+ * @brief Check the search deadlines. Once past the soft deadline, the search
+ *        continues (until the hard deadline) only while the most visited
+ *        root move differs from the one with the best average
  *
- * @todo Clear memory pool between calls to this method?
+ * @return True if the search should stop
+ */
+bool Mtcs::OutOfTime() const {
+    if (HardLimitReached()) return true;
+    if (!SoftLimitReached()) return false;
+
+    const Node* most_visited = nullptr;
+    const Node* best_average = nullptr;
+
+    for (const Node* node = root_node_.childs_;
+         node < root_node_.childs_ + root_node_.num_childs_; node++) {
+        if (node->Visits() == 0u) continue;
+
+        if (most_visited == nullptr ||
+            node->Visits() > most_visited->Visits()) {
+            most_visited = node;
+        }
+
+        // Child averages are from the opponent's perspective
+
+        if (best_average == nullptr ||
+            node->Average() < best_average->Average()) {
+            best_average = node;
+        }
+    }
+
+    return most_visited == best_average;
+}
+
+/**
+ * @brief Make a node the new root of the tree. Every other node is returned
+ *        to the pool
+ *
+ * @param node A node in the current tree
+ */
+void Mtcs::Promote(Node* node) {
+    // Copy the node first, since the block holding it is about to be freed
+
+    Node* const childs = node->childs_;
+    const std::uint8_t num_childs = node->num_childs_;
+    const bool expanded = node->expanded_.load();
+    const std::uint32_t visits = node->Visits();
+
+    Release(&root_node_, node);
+
+    root_node_.childs_ = childs;
+    root_node_.num_childs_ = num_childs;
+    root_node_.expanded_ = expanded;
+    root_visits_ = visits;
+}
+
+/**
+ * @brief Return the children of a node to the pool, recursively
+ *
+ * @param node The root of the subtree
+ * @param keep A node within the subtree whose own children are kept. Note the
+ *             block holding \a keep itself is freed
+ */
+void Mtcs::Release(Node* node, const Node* keep) {
+    if (node == keep || node->childs_ == nullptr) return;
+
+    for (std::size_t i = 0; i < node->num_childs_; i++) {
+        Release(&node->childs_[i], keep);
+    }
+
+    node_pool_->Free(node->childs_, node->num_childs_);
+
+    node->childs_ = nullptr;
+    node->num_childs_ = 0;
+    node->expanded_ = false;
+}
+
+/**
+ * @brief Get the number of visits to the root
+ *
+ * @return The total number of playouts below the root, including those
+ *         inherited from a reused tree
+ */
+std::size_t Mtcs::RootVisits() const noexcept {
+    return root_visits_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @see Search::Run()
  */
 std::uint32_t Mtcs::Run(const Position& position) {
     if (GameResult(position) != Result::kGameNotOver) {
         return kNullMove;
     }
 
-    const std::size_t n_iterations = 2000;
+    // Keep the subtree for this position if the game has advanced by one
+    // or two moves since the last search. Otherwise, start a new tree
+
+    const bool have_tree = root_node_.expanded_.load();
+
+    bool reused = have_tree && position == root_;
+
+    if (!reused && have_tree) {
+        reused = root_.ToMove() == Player::kWhite ?
+            Reuse<Player::kWhite>(position) :
+            Reuse<Player::kBlack>(position);
+    }
+
+    if (reused) {
+        logger_->Write("Reusing subtree with %zu visits\n", RootVisits());
+    } else {
+        Clear();
+        root_ = position;
+    }
+
+    // Expand every root child up front, so the root never changes shape
+    // while threads are searching
+
+    const bool expanded = position.ToMove() == Player::kWhite ?
+        ExpandRoot<Player::kWhite>() : ExpandRoot<Player::kBlack>();
+
+    if (!expanded) {
+        logger_->Write("Out of memory; unable to expand the root\n");
+        return kNullMove;
+    }
+
+    iterations_ = 0;
+    seldepth_ = 0;
+
+    using Clock = std::chrono::steady_clock;
+
+    const Clock::time_point start = Clock::now();
+
+    auto elapsed = [start]() -> std::int64_t {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            Clock::now() - start).count();
+    };
+
+    std::atomic<std::size_t> claimed(0);
+    std::atomic<std::int64_t> last_info(0);
+    std::atomic<bool> out_of_time(false);
 
-    Position pos(position);
+    auto worker = [&]() {
+        Position pos(position);
+        GameHistory history(GetGameHistory());
 
-    std::pair<double, std::uint32_t> result;
+        while (!Stopped() && !out_of_time.load(std::memory_order_relaxed)) {
+            const std::size_t iteration =
+                claimed.fetch_add(1, std::memory_order_relaxed);
 
-    for (std::size_t iter = 1; iter <= n_iterations; iter++) {
-        result = pos.ToMove() == Player::kWhite ? 
-                                    SelectRoot<Player::kWhite>(&pos) :
-                                    SelectRoot<Player::kBlack>(&pos);
+            if (iteration >= max_iterations_) break;
 
-        if (node_pool_->Full()) {
-            logger_->Write("Ran out of memory after %zu iteration(s)",
-                           iter);
+            if (iteration % kTimeCheckInterval == 0u) {
+                if (OutOfTime()) {
+                    out_of_time = true;
+                    break;
+                }
+
+                // Whichever thread first notices a report is due sends it
+
+                const std::int64_t now = elapsed();
+                std::int64_t last = last_info.load(std::memory_order_relaxed);
+
+                if (now - last >= kInfoInterval &&
+                    last_info.compare_exchange_strong(last, now)) {
+                    SendInfo(Info(now));
+                }
+            }
+
+            pos.ToMove() == Player::kWhite ?
+                SelectRoot<Player::kWhite>(&pos, &history) :
+                SelectRoot<Player::kBlack>(&pos, &history);
         }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < n_threads_; i++) {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto& thread : threads) thread.join();
+
+    if (node_pool_->Full()) {
+        logger_->Write("Ran out of memory after %zu iteration(s)\n",
+                       iterations_.load());
     }
 
-    return result.second;
+    SendInfo(Info(elapsed()));
+
+    // Select the move corresponding to the node with the maximum visits
+
+    const Node* const childs = root_node_.childs_;
+    const Node* const end = childs + root_node_.num_childs_;
+
+    const Node* best = std::max_element(childs, end,
+                                        [](const Node& a, const Node& b) {
+                                            return a.Visits() < b.Visits();
+                                        });
+
+#if DEBUG_TRACE==1
+    for (const Node* node = childs; node < end; node++) {
+        logger_->Write("(Root): %s visits = %u average = %0.6f\n",
+                       util::ToLongAlgebraic(node->Move()).c_str(),
+                       node->Visits(),
+                       -node->Average());
+    }
+#endif
+
+    return best->Move();
+}
+
+/**
+ * @brief Set the number of iterations to run per search
+ *
+ * @param iterations The number of playouts to start from the root
+ */
+void Mtcs::SetIterations(std::size_t iterations) noexcept {
+    max_iterations_ = iterations;
+}
+
+/**
+ * @brief Set the number of threads to search with
+ *
+ * @param threads The number of threads, including the calling thread
+ */
+void Mtcs::SetThreads(std::size_t threads) noexcept {
+    n_threads_ = std::max<std::size_t>(threads, 1);
 }
 
 }  // namespace chess
@@ -4,15 +4,25 @@
  *  \date   11/10/2022
  */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <memory.h>
+#include <mutex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "argparse/argparse.hpp"
@@ -21,10 +31,341 @@
 #include "chess/command_dispatcher.h"
 #include "chess/data_buffer.h"
 #include "chess/interactive.h"
+#include "chess/perft_table.h"
 #include "chess/position.h"
 #include "chess/movegen.h"
 #include "chess/stdio_channel.h"
 
+/**
+ * The deepest the tree may be split for multi-threaded perft, in plies
+ */
+constexpr std::size_t kMaxSplitDepth = 8;
+
+/**
+ * Cache lookups made by the current thread, and how many of them hit. These
+ * are per thread so that perft workers do not contend on shared counters
+ */
+thread_local std::uint64_t hash_probes = 0;
+thread_local std::uint64_t hash_hits   = 0;
+
+/**
+ * @brief An independent subtree of a perft, identified by the moves which
+ *        lead to it from the root
+ */
+struct Subtree {
+    /**
+     * The moves from the root, of which the first \ref length are valid
+     */
+    std::array<std::uint32_t, kMaxSplitDepth> moves;
+
+    /**
+     * The number of moves from the root
+     */
+    std::size_t length;
+
+    /**
+     * Index of the root move this subtree lies under
+     */
+    std::size_t root;
+};
+
+/**
+ * @brief Leaf counts broken down by the type of the last move played
+ */
+struct PerftStats {
+    PerftStats& operator+=(const PerftStats& stats) noexcept {
+        captures    += stats.captures;
+        castles     += stats.castles;
+        checkmates  += stats.checkmates;
+        checks      += stats.checks;
+        en_passants += stats.en_passants;
+        nodes       += stats.nodes;
+        promotions  += stats.promotions;
+        return *this;
+    }
+
+    /** Leaves reached by a capture, including en passant */
+    std::uint64_t captures;
+
+    /** Leaves reached by castling */
+    std::uint64_t castles;
+
+    /** Leaves at which the player to move is checkmated */
+    std::uint64_t checkmates;
+
+    /** Leaves at which the player to move is in check */
+    std::uint64_t checks;
+
+    /** Leaves reached by an en passant capture */
+    std::uint64_t en_passants;
+
+    /** All leaves */
+    std::uint64_t nodes;
+
+    /** Leaves reached by a promotion */
+    std::uint64_t promotions;
+};
+
+/**
+ * @brief Counts leaves for Perft::Trace(). The general case only counts
+ *        them, so the last ply is counted without generating any moves
+ *
+ * @tparam Count The type of a leaf count
+ */
+template <typename Count>
+struct LeafCounter {
+    /**
+     * @brief Count a single leaf, reached without a move
+     */
+    static Count Leaf() noexcept {
+        return 1u;
+    }
+
+    /**
+     * @brief Count the leaves one ply below a position
+     *
+     * @tparam P The player to move
+     *
+     * @param pos The position
+     * @param ply The ply of \a pos
+     */
+    template <chess::Player P>
+    static Count Children(chess::Position* pos, std::uint32_t ) noexcept {
+        return chess::CountLegalMoves<P>(*pos);
+    }
+};
+
+/**
+ * @brief Gathers \ref PerftStats by classifying each move of the last ply,
+ *        which must then be played to look for checks and mates
+ */
+template <>
+struct LeafCounter<PerftStats> {
+    static PerftStats Leaf() noexcept {
+        PerftStats stats{};
+        stats.nodes = 1;
+        return stats;
+    }
+
+    template <chess::Player P>
+    static PerftStats Children(chess::Position* pos,
+                               std::uint32_t ) noexcept {
+        constexpr chess::Player opponent = chess::util::opponent<P>();
+
+        std::uint32_t moves[chess::kMaxMoves];
+        const std::size_t n_moves = !pos->InCheck<P>() ?
+            chess::GenerateLegalMoves<P>(*pos, moves) :
+            chess::GenerateCheckEvasions<P>(*pos, moves);
+
+        PerftStats stats{};
+        stats.nodes = n_moves;
+
+        const chess::Square ep_target = pos->EnPassantTarget();
+
+        for (std::size_t i = 0; i < n_moves; i++) {
+            const std::uint32_t move = moves[i];
+
+            const chess::Piece captured = chess::util::ExtractCaptured(move);
+            const chess::Square from = chess::util::ExtractFrom(move);
+            const chess::Piece moved = chess::util::ExtractMoved(move);
+            const chess::Piece promoted = chess::util::ExtractPromoted(move);
+            const chess::Square to = chess::util::ExtractTo(move);
+
+            if (captured != chess::Piece::EMPTY) {
+                stats.captures++;
+
+                // Only an en passant capture lands on an empty square
+
+                if (moved == chess::Piece::PAWN && to == ep_target) {
+                    stats.en_passants++;
+                }
+            }
+
+            if (moved == chess::Piece::KING && std::abs(to - from) == 2) {
+                stats.castles++;
+            }
+
+            if (promoted != chess::Piece::EMPTY) stats.promotions++;
+
+            chess::Position::UndoInfo undo;
+            pos->MakeMove<P>(move, &undo);
+
+            if (pos->InCheck<opponent>()) {
+                stats.checks++;
+
+                std::uint32_t replies[chess::kMaxMoves];
+                if (chess::GenerateCheckEvasions<opponent>(*pos, replies)
+                        == 0) {
+                    stats.checkmates++;
+                }
+            }
+
+            pos->UnMakeMove<P>(move, undo);
+        }
+
+        return stats;
+    }
+};
+
+/**
+ * @brief A worker's queue of subtrees. The owner takes work from the back
+ *        while idle workers steal from the front
+ */
+class WorkQueue final {
+public:
+    WorkQueue() = default;
+
+    WorkQueue(const WorkQueue& queue)            = delete;
+    WorkQueue(WorkQueue&& queue)                 = delete;
+    WorkQueue& operator=(const WorkQueue& queue) = delete;
+    WorkQueue& operator=(WorkQueue&& queue)      = delete;
+
+    ~WorkQueue() = default;
+
+    /**
+     * @brief Take the most recently added subtree
+     *
+     * @param[out] subtree The subtree
+     *
+     * @return False if the queue is empty
+     */
+    bool Pop(Subtree* subtree) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (subtrees_.empty()) return false;
+
+        *subtree = subtrees_.back();
+        subtrees_.pop_back();
+
+        return true;
+    }
+
+    /**
+     * @brief Add a subtree
+     *
+     * @param subtree The subtree
+     */
+    void Push(const Subtree& subtree) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        subtrees_.push_back(subtree);
+    }
+
+    /**
+     * @brief Take the least recently added subtree
+     *
+     * @param[out] subtree The subtree
+     *
+     * @return False if the queue is empty
+     */
+    bool Steal(Subtree* subtree) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (subtrees_.empty()) return false;
+
+        *subtree = subtrees_.front();
+        subtrees_.pop_front();
+
+        return true;
+    }
+
+private:
+    /**
+     * Serializes access to the queue
+     */
+    std::mutex mutex_;
+
+    /**
+     * The queued subtrees
+     */
+    std::deque<Subtree> subtrees_;
+};
+
+/**
+ * @brief A test position from an EPD perft suite
+ */
+struct SuiteEntry {
+    /**
+     * The expected leaf counts, as (depth, nodes) pairs
+     */
+    std::vector<std::pair<std::size_t, std::uint64_t>> expected;
+
+    /**
+     * The position, in FEN
+     */
+    std::string fen;
+
+    /**
+     * The line of the EPD file this position was read from
+     */
+    std::size_t line;
+};
+
+/**
+ * @brief Parse one line of an EPD perft suite. Each line holds a FEN
+ *        followed by the expected counts, e.g. "<fen> ;D1 20 ;D2 400"
+ *
+ * @param[in]  text  The line
+ * @param[out] entry The parsed position
+ *
+ * @return True on success
+ */
+bool ParseSuiteEntry(const std::string& text, SuiteEntry* entry) {
+    std::size_t end = text.find(';');
+
+    const jfern::superstring fen(text.substr(0, end));
+    const std::vector<std::string> fields = fen.split();
+
+    entry->fen = jfern::superstring::build(" ", fields.begin(),
+                                           fields.end());
+    entry->expected.clear();
+
+    while (end != std::string::npos) {
+        const std::size_t begin = end + 1;
+        end = text.find(';', begin);
+
+        std::istringstream stream(text.substr(begin, end - begin));
+
+        std::string tag;
+        std::uint64_t nodes;
+
+        if (!(stream >> tag >> nodes) || tag.size() < 2 || tag[0] != 'D') {
+            return false;
+        }
+
+        try {
+            entry->expected.emplace_back(std::stoul(tag.substr(1)), nodes);
+        } catch (const std::exception& ) {
+            return false;
+        }
+    }
+
+    return !entry->fen.empty() && !entry->expected.empty();
+}
+
+/**
+ * @brief Quote a string for inclusion in a JSON document
+ *
+ * @param text The string to quote
+ *
+ * @return The quoted, escaped string
+ */
+std::string JsonQuote(const std::string& text) {
+    std::string quoted = "\"";
+
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            quoted += ' ';
+        } else {
+            quoted += c;
+        }
+    }
+
+    return quoted + "\"";
+}
+
 /**
  * @brief PERFormance Test
  */
@@ -33,13 +374,28 @@ public:
     /**
      * @brief Constructor
      * 
-     * @param channel Channel to listen for user commands
+     * @param channel     Channel to listen for user commands
+     * @param threads     The number of threads to count with
+     * @param split_depth The depth at which to split the tree between
+     *                    threads, in plies
+     * @param hash_mb     The size of the subtree cache, in megabytes, or 0
+     *                    to count without one
      */
-    explicit Perft(std::shared_ptr<chess::InputStreamChannel> channel)
+    Perft(std::shared_ptr<chess::InputStreamChannel> channel,
+          std::size_t threads,
+          std::size_t split_depth,
+          std::size_t hash_mb)
         : dispatcher_(),
+          hash_hits_(0),
+          hash_probes_(0),
           input_channel_(channel),
           max_depth_(0),
-          position_() {
+          position_(),
+          split_depth_(std::clamp<std::size_t>(split_depth, 1,
+                                                kMaxSplitDepth)),
+          table_(hash_mb > 0 ? std::make_unique<chess::PerftTable>(hash_mb) :
+                               nullptr),
+          threads_(std::max<std::size_t>(threads, 1)) {
         dispatcher_.RegisterCommand(
             "divide",
             std::bind(&Perft::HandleCommandDivide, this,
@@ -60,6 +416,10 @@ public:
             "position",
             std::bind(&Perft::HandleCommandPosition, this,
                       std::placeholders::_1));
+        dispatcher_.RegisterCommand(
+            "stats",
+            std::bind(&Perft::HandleCommandStats, this,
+                      std::placeholders::_1));
         dispatcher_.RegisterCommand(
             "quit",
             std::bind(&Perft::HandleCommandQuit, this,
@@ -75,12 +435,209 @@ public:
                       std::placeholders::_1);
 
         position_.Reset();
+    }
 
-        std::cout << "Type \"help\" for options."
-                  << std::endl;
+    /**
+     * @brief Run an EPD perft suite and write a JSON report of the results
+     *
+     * The positions are run one after another, each one counted on all
+     * \ref threads_ threads, so that the time and node rate reported for a
+     * position are its own
+     *
+     * @param epd       The EPD file, one position with its expected counts
+     *                  per line. Blank lines and lines starting with '#' are
+     *                  skipped
+     * @param max_depth Skip expected counts deeper than this, or 0 to run
+     *                  them all
+     * @param report    The file to write the JSON report to
+     *
+     * @return True if every position passed
+     */
+    bool RunSuite(const std::string& epd, std::size_t max_depth,
+                  const std::string& report) {
+        std::ifstream input(epd);
+        if (!input) {
+            std::cout << "Unable to open \"" << epd << "\"" << std::endl;
+            return false;
+        }
+
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(3);
+        json << "{\n  \"epd\": " << JsonQuote(epd) << ",\n"
+             << "  \"threads\": " << threads_ << ",\n"
+             << "  \"hash_mb\": "
+             << (table_ ? table_->Size() / (1024 * 1024) : 0) << ",\n"
+             << "  \"positions\": [";
+
+        std::size_t passed = 0, failed = 0;
+        std::uint64_t total_nodes = 0;
+        std::chrono::microseconds total_time(0);
+
+        std::string text;
+        for (std::size_t line = 1; std::getline(input, text); line++) {
+            const std::vector<std::string> tokens =
+                jfern::superstring(text).split();
+            if (tokens.empty() || tokens[0][0] == '#') continue;
+
+            SuiteEntry entry;
+            entry.line = line;
+
+            std::string error;
+
+            if (!ParseSuiteEntry(text, &entry)) {
+                error = "Malformed EPD line";
+                entry.fen = text;
+            } else {
+                const chess::Position::FenError fen_error =
+                    position_.Reset(entry.fen);
+
+                if (fen_error != chess::Position::FenError::kSuccess) {
+                    error = chess::Position::ErrorToString(fen_error);
+                }
+            }
+
+            bool pass = error.empty();
+            std::uint64_t nodes = 0;
+            std::chrono::microseconds time(0);
+
+            std::ostringstream depths;
+            depths << std::fixed << std::setprecision(3);
+
+            for (std::size_t i = 0; error.empty() &&
+                     i < entry.expected.size(); i++) {
+                const auto [depth, expected] = entry.expected[i];
+
+                if (max_depth != 0 && depth > max_depth) continue;
+
+                if (depth > chess::kMaxMoves) {
+                    error = "Depth out of range";
+                    pass = false;
+                    break;
+                }
+
+                const auto start = std::chrono::steady_clock::now();
+
+                const std::uint64_t count = TraceAll(depth);
+
+                const auto elapsed =
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start);
+
+                pass = pass && count == expected;
+                nodes += count;
+                time  += elapsed;
+
+                depths << (depths.tellp() > 0 ? "," : "") << "\n"
+                       << "        {\"depth\": " << depth
+                       << ", \"expected\": " << expected
+                       << ", \"nodes\": " << count
+                       << ", \"pass\": " << (count == expected ?
+                                                "true" : "false")
+                       << ", \"time_ms\": " << elapsed.count() / 1000.0
+                       << "}";
+
+                if (count != expected) {
+                    std::cout << "line " << line << ": D" << depth
+                              << " expected " << expected << " but got "
+                              << count << std::endl;
+                }
+            }
+
+            const std::uint64_t nps = time.count() > 0 ?
+                nodes * 1000000 / time.count() : 0;
+
+            std::cout << (pass ? "PASS" : "FAIL") << " line " << line
+                      << " nodes=" << nodes
+                      << " time=" << time.count() / 1000 << "ms"
+                      << " nps=" << nps;
+            if (!error.empty()) std::cout << " (" << error << ")";
+            std::cout << std::endl;
+
+            json << (passed + failed == 0 ? "" : ",") << "\n"
+                 << "    {\n"
+                 << "      \"line\": " << line << ",\n"
+                 << "      \"fen\": " << JsonQuote(entry.fen) << ",\n"
+                 << "      \"pass\": " << (pass ? "true" : "false") << ",\n";
+            if (!error.empty()) {
+                json << "      \"error\": " << JsonQuote(error) << ",\n";
+            }
+            json << "      \"nodes\": " << nodes << ",\n"
+                 << "      \"time_ms\": " << time.count() / 1000.0 << ",\n"
+                 << "      \"nps\": " << nps << ",\n"
+                 << "      \"depths\": [" << depths.str()
+                 << (depths.str().empty() ? "]\n" : "\n      ]\n")
+                 << "    }";
+
+            pass ? passed++ : failed++;
+            total_nodes += nodes;
+            total_time  += time;
+        }
+
+        const std::uint64_t total_nps = total_time.count() > 0 ?
+            total_nodes * 1000000 / total_time.count() : 0;
+
+        json << (passed + failed == 0 ? "],\n" : "\n  ],\n")
+             << "  \"passed\": " << passed << ",\n"
+             << "  \"failed\": " << failed << ",\n"
+             << "  \"nodes\": " << total_nodes << ",\n"
+             << "  \"time_ms\": " << total_time.count() / 1000.0 << ",\n"
+             << "  \"nps\": " << total_nps << "\n"
+             << "}\n";
+
+        std::ofstream output(report);
+        if (!(output << json.str())) {
+            std::cout << "Unable to write \"" << report << "\""
+                      << std::endl;
+            return false;
+        }
+
+        std::cout << "Passed " << passed << "/" << passed + failed
+                  << " positions, nodes=" << total_nodes
+                  << " time=" << total_time.count() / 1000 << "ms"
+                  << " nps=" << total_nps << std::endl;
+
+        return failed == 0;
     }
 
 private:
+    /**
+     * @brief Add the calling thread's cache statistics to the totals for the
+     *        current command, and reset them
+     */
+    void CollectHashStats() {
+        hash_probes_ += hash_probes;
+        hash_hits_   += hash_hits;
+
+        hash_probes = 0;
+        hash_hits   = 0;
+    }
+
+    /**
+     * @brief Print the cache hit rate of the last command, if the cache is
+     *        enabled
+     */
+    void ReportHashStats() const {
+        if (!table_) return;
+
+        const std::uint64_t probes = hash_probes_;
+        const std::uint64_t hits   = hash_hits_;
+
+        std::cout << "Hash probes=" << probes << " hits=" << hits
+                  << " rate=" << (probes ? 100.0 * hits / probes : 0.0)
+                  << "%" << std::endl;
+    }
+
+    /**
+     * @brief Clear the cache statistics before a new command
+     */
+    void ResetHashStats() {
+        hash_probes_ = 0;
+        hash_hits_   = 0;
+
+        hash_probes = 0;
+        hash_hits   = 0;
+    }
+
     /**
      * @brief Check the depth argument to the perft and divide commands
      *
@@ -121,6 +678,8 @@ private:
             if (!CheckDepth(parsed_depth))
                 return false;
 
+            ResetHashStats();
+
             const auto start = std::chrono::steady_clock::now();
 
             if (position_.ToMove() == chess::Player::kWhite) {
@@ -131,6 +690,8 @@ private:
 
             const auto stop  = std::chrono::steady_clock::now();
 
+            CollectHashStats();
+
             const std::size_t ms =
                 std::chrono::duration_cast<std::chrono::milliseconds>(
                     stop - start).count();
@@ -138,6 +699,8 @@ private:
             std::cout << "Nodes=" << nodes << " Time=" << ms
                       << "ms" << std::endl;
 
+            ReportHashStats();
+
             return true;
         } else {
             std::cout << "usage: divide <depth>" << std::endl;
@@ -170,6 +733,10 @@ private:
         std::cout << indentx1 << "position <fen>\n";
         std::cout << indentx2
                   << "Set the current position to a FEN-encoded one.\n";
+        std::cout << indentx1 << "stats <depth>\n";
+        std::cout << indentx2
+                  << "Like perft, but break down the terminal nodes by the"
+                     " type of the last move.\n";
         std::cout << indentx1 << "quit\n";
         std::cout << indentx2 << "Exit this program.\n"
                   << std::endl;
@@ -195,9 +762,11 @@ private:
                           << std::endl;
                 return false;
             } else {
+                chess::Position::UndoInfo undo;
+
                 position_.ToMove() == chess::Player::kWhite ?
-                    position_.MakeMove<chess::Player::kWhite>(move, 0) :
-                    position_.MakeMove<chess::Player::kBlack>(move, 0);
+                    position_.MakeMove<chess::Player::kWhite>(move, &undo) :
+                    position_.MakeMove<chess::Player::kBlack>(move, &undo);
             }
         }
 
@@ -226,18 +795,16 @@ private:
             if (!CheckDepth(parsed_depth))
                 return false;
 
-            max_depth_ = parsed_depth;
+            ResetHashStats();
 
             const auto start = std::chrono::steady_clock::now();
 
-            if (position_.ToMove() == chess::Player::kWhite) {
-                nodes = Trace<chess::Player::kWhite>(&position_, 0);
-            } else {
-                nodes = Trace<chess::Player::kBlack>(&position_, 0);
-            }
+            nodes = TraceAll(parsed_depth);
 
             const auto stop  = std::chrono::steady_clock::now();
 
+            CollectHashStats();
+
             const std::size_t ms =
                 std::chrono::duration_cast<std::chrono::milliseconds>(
                     stop - start).count();
@@ -245,6 +812,8 @@ private:
             std::cout << "Nodes=" << nodes << " Time=" << ms
                       << "ms" << std::endl;
 
+            ReportHashStats();
+
             return true;
         } else {
             std::cout << "usage: perft <depth>" << std::endl;
@@ -284,6 +853,53 @@ private:
         return true;
     }
 
+    /**
+     * @brief Handle the "stats" command
+     *
+     * @param args Arguments to this command
+     *
+     * @return True on success
+     */
+    bool HandleCommandStats(const std::vector<std::string>& args) {
+        if (!args.empty()) {
+            std::size_t parsed_depth;
+
+            try {
+                parsed_depth = std::stoul(args[0]);
+            } catch (const std::exception& e) {
+                std::cout << e.what() << std::endl;
+                return false;
+            }
+
+            if (!CheckDepth(parsed_depth))
+                return false;
+
+            const auto start = std::chrono::steady_clock::now();
+
+            const PerftStats stats = TraceAll<PerftStats>(parsed_depth);
+
+            const auto stop  = std::chrono::steady_clock::now();
+
+            const std::size_t ms =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    stop - start).count();
+
+            std::cout << "Nodes="      << stats.nodes
+                      << " Captures="   << stats.captures
+                      << " E.p.="       << stats.en_passants
+                      << " Castles="    << stats.castles
+                      << " Promotions=" << stats.promotions
+                      << " Checks="     << stats.checks
+                      << " Checkmates=" << stats.checkmates
+                      << " Time=" << ms << "ms" << std::endl;
+
+            return true;
+        } else {
+            std::cout << "usage: stats <depth>" << std::endl;
+            return false;
+        }
+    }
+
     /**
      * Called back when an unknown command is issued
      *
@@ -318,15 +934,26 @@ private:
             chess::GenerateLegalMoves<P>(*pos, moves) :
             chess::GenerateCheckEvasions<P>(*pos, moves);
 
-        for (std::size_t i = 0; i < n_moves; i++) {
-            const std::uint32_t move = moves[i];
+        std::vector<std::uint64_t> counts;
 
-            pos->MakeMove<P>(move, 0);
+        if (threads_ > 1 && depth > 1) {
+            counts = TraceRoot<P>(depth);
+        } else {
+            for (std::size_t i = 0; i < n_moves; i++) {
+                const std::uint32_t move = moves[i];
+
+                chess::Position::UndoInfo undo;
+                pos->MakeMove<P>(move, &undo);
 
-            const std::uint64_t nodes =
-                Trace<chess::util::opponent<P>()>(pos, 1);
+                counts.push_back(Trace<chess::util::opponent<P>()>(pos, 1));
 
-            pos->UnMakeMove<P>(move, 0);
+                pos->UnMakeMove<P>(move, undo);
+            }
+        }
+
+        for (std::size_t i = 0; i < n_moves; i++) {
+            const std::uint32_t move = moves[i];
+            const std::uint64_t nodes = counts[i];
 
             // Display the size of this subtree
 
@@ -352,34 +979,257 @@ private:
     }
 
     /**
-     * @brief Internal recursive routine
+     * @brief Collect the subtrees at the split depth
      *
      * @tparam P The player whose turn it is at this depth
      *
+     * @param pos      The current position
+     * @param split    The split depth
+     * @param subtree  The moves leading to the current position
+     * @param subtrees The subtrees found so far
+     */
+    template <chess::Player P>
+    static void Split(chess::Position* pos,
+                      std::size_t split,
+                      Subtree* subtree,
+                      std::vector<Subtree>* subtrees) {
+        const std::uint32_t ply = subtree->length;
+
+        if (ply >= split) {
+            subtrees->push_back(*subtree);
+            return;
+        }
+
+        std::uint32_t moves[chess::kMaxMoves];
+        const std::size_t n_moves = !pos->InCheck<P>() ?
+            chess::GenerateLegalMoves<P>(*pos, moves) :
+            chess::GenerateCheckEvasions<P>(*pos, moves);
+
+        for (std::size_t i = 0; i < n_moves; i++) {
+            const std::uint32_t move = moves[i];
+
+            if (ply == 0) subtree->root = i;
+
+            subtree->moves[ply] = move;
+            subtree->length = ply + 1;
+
+            chess::Position::UndoInfo undo;
+            pos->MakeMove<P>(move, &undo);
+
+            Split<chess::util::opponent<P>()>(pos, split, subtree, subtrees);
+
+            pos->UnMakeMove<P>(move, undo);
+        }
+
+        subtree->length = ply;
+    }
+
+    /**
+     * @brief Count the leaves of a subtree
+     *
+     * @tparam Count The type of a leaf count
+     *
+     * @param pos     The root position, which is restored on return
+     * @param subtree The subtree
+     *
+     * @return The number of leaves
+     */
+    template <typename Count>
+    Count TraceSubtree(chess::Position* pos, const Subtree& subtree) {
+        std::array<chess::Position::UndoInfo, kMaxSplitDepth> undo;
+
+        for (std::uint32_t ply = 0; ply < subtree.length; ply++) {
+            pos->ToMove() == chess::Player::kWhite ?
+                pos->MakeMove<chess::Player::kWhite>(subtree.moves[ply],
+                                                     &undo[ply]) :
+                pos->MakeMove<chess::Player::kBlack>(subtree.moves[ply],
+                                                     &undo[ply]);
+        }
+
+        const Count nodes = pos->ToMove() == chess::Player::kWhite ?
+            Trace<chess::Player::kWhite, Count>(pos, subtree.length) :
+            Trace<chess::Player::kBlack, Count>(pos, subtree.length);
+
+        for (std::uint32_t ply = subtree.length; ply > 0; ply--) {
+            // The player who made the move is not the one to move now
+
+            pos->ToMove() == chess::Player::kWhite ?
+                pos->UnMakeMove<chess::Player::kBlack>(
+                    subtree.moves[ply-1], undo[ply-1]) :
+                pos->UnMakeMove<chess::Player::kWhite>(
+                    subtree.moves[ply-1], undo[ply-1]);
+        }
+
+        return nodes;
+    }
+
+    /**
+     * @brief Count the leaves below each root move, sharing the work among
+     *        \ref threads_ workers
+     *
+     * The tree is split at \ref split_depth_ plies (but above the leaves)
+     * into independent subtrees, which are dealt out round-robin. Each
+     * worker counts its own subtrees on its own copy of the position, newest
+     * first, and once its queue runs dry steals the oldest subtree from
+     * another worker
+     *
+     * @tparam P     The player to move at the root
+     * @tparam Count The type of a leaf count
+     *
+     * @param depth The perft depth, at least 2
+     *
+     * @return The number of leaves below each root move, in move generator
+     *         order
+     */
+    template <chess::Player P, typename Count = std::uint64_t>
+    std::vector<Count> TraceRoot(std::size_t depth) {
+        max_depth_ = depth;
+
+        std::vector<Subtree> subtrees;
+        Subtree subtree{};
+
+        chess::Position position(position_);
+
+        Split<P>(&position, std::min(split_depth_, depth-1), &subtree,
+                 &subtrees);
+
+        std::uint32_t moves[chess::kMaxMoves];
+        const std::size_t n_moves = !position.InCheck<P>() ?
+            chess::GenerateLegalMoves<P>(position, moves) :
+            chess::GenerateCheckEvasions<P>(position, moves);
+
+        std::vector<WorkQueue> queues(threads_);
+
+        for (std::size_t i = 0; i < subtrees.size(); i++) {
+            queues[i % threads_].Push(subtrees[i]);
+        }
+
+        std::vector<std::vector<Count>> counts(
+            threads_, std::vector<Count>(n_moves, Count{}));
+
+        auto worker = [&](std::size_t id) {
+            chess::Position pos(position_);
+            Subtree next;
+
+            while (true) {
+                bool found = queues[id].Pop(&next);
+
+                for (std::size_t i = 1; !found && i < threads_; i++) {
+                    found = queues[(id + i) % threads_].Steal(&next);
+                }
+
+                if (!found) break;
+
+                counts[id][next.root] += TraceSubtree<Count>(&pos, next);
+            }
+
+            CollectHashStats();
+        };
+
+        std::vector<std::thread> workers;
+        for (std::size_t id = 0; id < threads_; id++) {
+            workers.emplace_back(worker, id);
+        }
+
+        for (auto& thread : workers) thread.join();
+
+        std::vector<Count> totals(n_moves, Count{});
+        for (const auto& count : counts) {
+            for (std::size_t i = 0; i < n_moves; i++) totals[i] += count[i];
+        }
+
+        return totals;
+    }
+
+    /**
+     * @brief Count the leaves below the current position, on \ref threads_
+     *        threads
+     *
+     * @tparam Count The type of a leaf count
+     *
+     * @param depth The perft depth
+     *
+     * @return The number of leaves
+     */
+    template <typename Count = std::uint64_t>
+    Count TraceAll(std::size_t depth) {
+        max_depth_ = depth;
+
+        if (threads_ > 1 && depth > 1) {
+            const std::vector<Count> counts =
+                position_.ToMove() == chess::Player::kWhite ?
+                    TraceRoot<chess::Player::kWhite, Count>(depth) :
+                    TraceRoot<chess::Player::kBlack, Count>(depth);
+
+            Count nodes{};
+            for (const Count& count : counts) nodes += count;
+
+            return nodes;
+        } else if (position_.ToMove() == chess::Player::kWhite) {
+            return Trace<chess::Player::kWhite, Count>(&position_, 0);
+        } else {
+            return Trace<chess::Player::kBlack, Count>(&position_, 0);
+        }
+    }
+
+    /**
+     * @brief Internal recursive routine
+     *
+     * Only plain leaf counts are cached
+     *
+     * @tparam P     The player whose turn it is at this depth
+     * @tparam Count The type of a leaf count, either a plain number or
+     *               \ref PerftStats
+     *
      * @param pos   The current position
      * @param depth The current depth
      */
-    template <chess::Player P>
-    std::size_t Trace(chess::Position* pos, std::uint32_t depth) {
+    template <chess::Player P, typename Count = std::uint64_t>
+    Count Trace(chess::Position* pos, std::uint32_t depth) {
+        constexpr bool cacheable = std::is_same_v<Count, std::uint64_t>;
+
         std::uint32_t moves[chess::kMaxMoves];
 
-        if (depth >= max_depth_) return 1u;
+        if (depth >= max_depth_) return LeafCounter<Count>::Leaf();
+
+        const std::uint32_t remaining = max_depth_ - depth;
+
+        Count nodes{};
+
+        // Subtrees one ply deep are counted without generating any moves,
+        // which is cheaper than a cache lookup
+
+        if constexpr (cacheable) {
+            if (table_ && remaining > 1) {
+                hash_probes++;
+
+                if (table_->Probe(pos->Hash(), remaining, &nodes)) {
+                    hash_hits++;
+                    return nodes;
+                }
+            }
+        }
+
+        if (remaining == 1) {
+            return LeafCounter<Count>::template Children<P>(pos, depth);
+        }
 
         const std::size_t n_moves = !pos->InCheck<P>() ?
             chess::GenerateLegalMoves<P>(*pos, moves) :
             chess::GenerateCheckEvasions<P>(*pos, moves);
 
-        if (depth+1 >= max_depth_) return n_moves;
-
-        std::uint64_t nodes = 0;
-
         for (std::size_t i = 0; i < n_moves; i++) {
             const std::uint32_t move = moves[i];
-            pos->MakeMove<P>(move, depth);
+            chess::Position::UndoInfo undo;
+            pos->MakeMove<P>(move, &undo);
+
+            nodes += Trace<chess::util::opponent<P>(), Count>(pos, depth+1);
 
-            nodes += Trace<chess::util::opponent<P>()>(pos, depth+1);
+            pos->UnMakeMove<P>(move, undo);
+        }
 
-            pos->UnMakeMove<P>(move, depth);
+        if constexpr (cacheable) {
+            if (table_) table_->Store(pos->Hash(), remaining, nodes);
         }
 
         return nodes;
@@ -390,6 +1240,16 @@ private:
      */
     chess::CommandDispatcher dispatcher_;
 
+    /**
+     * Cache hits during the current command, summed over all threads
+     */
+    std::atomic<std::uint64_t> hash_hits_;
+
+    /**
+     * Cache lookups during the current command, summed over all threads
+     */
+    std::atomic<std::uint64_t> hash_probes_;
+
     /**
      * Channel to listen for commands
      */
@@ -405,6 +1265,21 @@ private:
      * The position on which to run perft calculations
      */
     chess::Position position_;
+
+    /**
+     * The depth at which the tree is split between threads, in plies
+     */
+    std::size_t split_depth_;
+
+    /**
+     * Cache of subtree sizes shared by all threads, or null if disabled
+     */
+    std::unique_ptr<chess::PerftTable> table_;
+
+    /**
+     * The number of threads to count with
+     */
+    std::size_t threads_;
 };
 
 /**
@@ -412,10 +1287,25 @@ private:
  *
  * @return True on success
  */
-bool go(const argparse::ArgumentParser& ) {
+bool go(const argparse::ArgumentParser& parser) {
     auto channel = std::make_shared<chess::StdinChannel>(true);
 
-    Perft perft(channel);
+    Perft perft(channel,
+                parser.get<std::size_t>("--threads"),
+                parser.get<std::size_t>("--split-depth"),
+                parser.get<std::size_t>("--hash"));
+
+    const auto epd = parser.get<std::string>("--epd");
+
+    if (!epd.empty()) {
+        return perft.RunSuite(epd,
+                              parser.get<std::size_t>("--depth"),
+                              parser.get<std::string>("--report"));
+    }
+
+    std::cout << "Type \"help\" for options."
+              << std::endl;
+
     while (!channel->IsClosed()) channel->Poll();
 
     return true;
@@ -424,6 +1314,30 @@ bool go(const argparse::ArgumentParser& ) {
 int main(int argc, char** argv) {
     argparse::ArgumentParser parser("perft");
 
+    parser.add_argument("--threads")
+        .help("Number of threads to count with")
+        .default_value(std::size_t(1))
+        .scan<'u', std::size_t>();
+    parser.add_argument("--hash")
+        .help("Size of the subtree cache, in megabytes (0 to disable)")
+        .default_value(std::size_t(0))
+        .scan<'u', std::size_t>();
+    parser.add_argument("--epd")
+        .help("Run the perft suite in this EPD file instead of reading"
+              " commands")
+        .default_value(std::string());
+    parser.add_argument("--depth")
+        .help("With --epd, skip counts deeper than this (0 for no limit)")
+        .default_value(std::size_t(0))
+        .scan<'u', std::size_t>();
+    parser.add_argument("--report")
+        .help("With --epd, the file to write the JSON report to")
+        .default_value(std::string("perft_report.json"));
+    parser.add_argument("--split-depth")
+        .help("Depth at which to split the tree between threads, in plies")
+        .default_value(std::size_t(3))
+        .scan<'u', std::size_t>();
+
     try {
         parser.parse_args(argc, argv);
     } catch (const std::runtime_error& error) {
@@ -0,0 +1,165 @@
+/**
+ *  \file   perft_table.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include "chess/perft_table.h"
+
+#include <algorithm>
+
+namespace chess {
+namespace {
+constexpr int kDepthShift = 56;
+
+constexpr std::uint64_t Pack(std::uint32_t depth,
+                             std::uint64_t nodes) noexcept {
+    return (std::uint64_t(std::uint8_t(depth)) << kDepthShift) |
+        (nodes & PerftTable::kMaxNodes);
+}
+
+constexpr std::uint32_t UnpackDepth(std::uint64_t data) noexcept {
+    return static_cast<std::uint32_t>(data >> kDepthShift);
+}
+
+constexpr std::uint64_t UnpackNodes(std::uint64_t data) noexcept {
+    return data & PerftTable::kMaxNodes;
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor
+ *
+ * @param megabytes The maximum table size, in megabytes
+ */
+PerftTable::PerftTable(std::size_t megabytes) : buckets_(), mask_(0) {
+    Resize(megabytes);
+}
+
+/**
+ * @brief Erase all entries
+ *
+ * @note Not safe to call while other threads are using the table
+ */
+void PerftTable::Clear() noexcept {
+    for (std::size_t i = 0; i <= mask_; i++) {
+        for (auto& slot : buckets_[i].slots) {
+            slot.check.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Look up the size of a subtree
+ *
+ * @param[in]  key   The hash key of the subtree's root position
+ * @param[in]  depth The depth remaining below that position, in
+ *                   [1, \ref kMaxDepth]
+ * @param[out] nodes The number of leaves in the subtree, if found
+ *
+ * @return True if an entry for \a key and \a depth was found
+ */
+bool PerftTable::Probe(std::uint64_t key, std::uint32_t depth,
+                       std::uint64_t* nodes) const noexcept {
+    if (depth > kMaxDepth) return false;
+
+    for (const auto& slot : BucketFor(key).slots) {
+        const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+        const std::uint64_t check =
+            slot.check.load(std::memory_order_relaxed);
+
+        if ((check ^ data) == key && UnpackDepth(data) == depth) {
+            *nodes = UnpackNodes(data);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Reallocate the table. All entries are lost
+ *
+ * @param megabytes The maximum table size, in megabytes. The actual size is
+ *                  rounded down to a power of two number of buckets
+ */
+void PerftTable::Resize(std::size_t megabytes) {
+    const std::size_t max_buckets =
+        std::max<std::size_t>(megabytes * 1024 * 1024 / sizeof(Bucket), 1);
+
+    std::size_t n_buckets = 1;
+    while (n_buckets * 2 <= max_buckets) n_buckets *= 2;
+
+    buckets_.reset(new Bucket[n_buckets]);
+    mask_ = n_buckets - 1;
+
+    Clear();
+}
+
+/**
+ * @brief Get the size of the table
+ *
+ * @return The table size, in bytes
+ */
+std::size_t PerftTable::Size() const noexcept {
+    return (mask_ + 1) * sizeof(Bucket);
+}
+
+/**
+ * @brief Record the size of a subtree
+ *
+ * An existing entry for \a key and \a depth is overwritten. Otherwise an
+ * empty slot in the bucket is used if there is one, or else the slot holding
+ * the shallowest subtree is replaced, since it is the cheapest to count
+ * again. Subtrees too deep or too large to store are ignored
+ *
+ * @param key   The hash key of the subtree's root position
+ * @param depth The depth remaining below that position, in
+ *              [1, \ref kMaxDepth]
+ * @param nodes The number of leaves in the subtree
+ */
+void PerftTable::Store(std::uint64_t key, std::uint32_t depth,
+                       std::uint64_t nodes) noexcept {
+    if (depth > kMaxDepth || nodes > kMaxNodes) return;
+
+    Slot* replace = nullptr;
+    std::uint32_t replace_depth = 0;
+
+    for (auto& slot : BucketFor(key).slots) {
+        const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+        const std::uint64_t check =
+            slot.check.load(std::memory_order_relaxed);
+
+        const std::uint32_t slot_depth = UnpackDepth(data);
+
+        if ((check ^ data) == key && slot_depth == depth) {
+            replace = &slot;
+            break;
+        }
+
+        if (replace == nullptr || slot_depth < replace_depth) {
+            replace = &slot;
+            replace_depth = slot_depth;
+        }
+    }
+
+    const std::uint64_t data = Pack(depth, nodes);
+
+    replace->check.store(key ^ data, std::memory_order_relaxed);
+    replace->data.store(data, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the bucket a key maps to
+ *
+ * @param key The position's hash key
+ *
+ * @return The bucket in which \a key may be stored
+ */
+auto PerftTable::BucketFor(std::uint64_t key) const noexcept -> Bucket& {
+    return buckets_[key & mask_];
+}
+
+}  // namespace chess
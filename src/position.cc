@@ -93,11 +93,43 @@ Position::Position() :
     en_passant_target_(Square::Overflow),
     full_move_number_(0),
     half_move_number_(0),
-    history_(),
+    hash_(0),
     pieces_(),
     to_move_(Player::kBoth) {
 }
 
+/**
+ * Compute the Zobrist hash signature of this position from scratch. This
+ * is used to seed the incremental updates done in MakeMove() and to verify
+ * them
+ *
+ * @return The hash signature
+ */
+std::uint64_t Position::ComputeHash() const noexcept {
+    std::uint64_t hash = 0;
+
+    for (auto square = Square::H1; square <= Square::A8; square++) {
+        const Piece piece = pieces_[square];
+        if (piece == Piece::EMPTY) continue;
+
+        if (OccupiedBy<Player::kWhite>(square)) {
+            hash ^= data_tables::kZobristPiece<Player::kWhite>[piece][square];
+        } else {
+            hash ^= data_tables::kZobristPiece<Player::kBlack>[piece][square];
+        }
+    }
+
+    hash ^= data_tables::kZobristCastle[CastleRights()];
+
+    if (to_move_ == Player::kWhite) {
+        hash ^= EnPassantKey<Player::kWhite>();
+    } else {
+        hash ^= EnPassantKey<Player::kBlack>() ^ data_tables::kZobristToMove;
+    }
+
+    return hash;
+}
+
 /**
  * Display the current position
  *
@@ -348,6 +380,7 @@ auto Position::Reset(const std::string& fen_) -> FenError {
 
     const auto error_code = Validate(pos);
     if (error_code == FenError::kSuccess) {
+        pos.hash_ = pos.ComputeHash();
         *this = std::move(pos);
     }
 
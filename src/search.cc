@@ -0,0 +1,61 @@
+/**
+ *  \file   search.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include "chess/search.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+#include "chess/util.h"
+
+namespace chess {
+/**
+ * @brief Send a UCI "info" line describing the progress of the search. Does
+ *        nothing if no channel was set
+ *
+ * @param info The search progress
+ */
+void Search::SendInfo(const SearchInfo& info) const {
+    if (!info_channel_) return;
+
+    std::string pv;
+
+    for (std::uint32_t move : info.pv) {
+        std::string text = util::ToLongAlgebraic(move);
+
+        text.erase(std::remove(text.begin(), text.end(), ' '), text.end());
+        std::transform(text.begin(), text.end(), text.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+
+        pv += " " + text;
+    }
+
+    const std::uint64_t nps =
+        info.time > 0 ? info.nodes * 1000 / info.time : 0;
+
+    std::string hashfull;
+    if (info.hashfull >= 0) {
+        hashfull = " hashfull " + std::to_string(info.hashfull);
+    }
+
+    info_channel_->Write(
+        "info depth %d seldepth %d score %s %d nodes %llu nps %llu%s "
+        "time %lld%s%s\n",
+        info.depth,
+        std::max(info.seldepth, info.depth),
+        info.mate ? "mate" : "cp",
+        info.score,
+        static_cast<unsigned long long>(info.nodes),
+        static_cast<unsigned long long>(nps),
+        hashfull.c_str(),
+        static_cast<long long>(info.time),
+        pv.empty() ? "" : " pv",
+        pv.c_str());
+    info_channel_->Flush();
+}
+
+}  // namespace chess
@@ -10,7 +10,8 @@ namespace chess {
 /**
  * @brief Default constructor
  */
-OutputStreamChannel::OutputStreamChannel() : message_(), size_(0) {
+OutputStreamChannel::OutputStreamChannel()
+    : message_(), mutex_(), size_(0) {
     Resize(1024);
 }
 
@@ -23,6 +24,7 @@ OutputStreamChannel::OutputStreamChannel() : message_(), size_(0) {
  * @return *this
  */
 OutputStreamChannel& OutputStreamChannel::operator<<(const std::string& str) {
+    std::lock_guard<std::mutex> lock(mutex_);
     Write(ConstDataBuffer(str.c_str(), str.size()));
     return *this;
 }
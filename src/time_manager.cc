@@ -0,0 +1,174 @@
+/**
+ *  \file   time_manager.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include "chess/time_manager.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace chess {
+namespace {
+constexpr auto kNoDeadline =
+    std::numeric_limits<TimeManager::Clock::rep>::max();
+
+/**
+ * @brief Convert milliseconds to clock ticks
+ */
+TimeManager::Clock::rep ToTicks(std::int64_t milliseconds) noexcept {
+    return std::chrono::duration_cast<TimeManager::Clock::duration>(
+        std::chrono::milliseconds(milliseconds)).count();
+}
+
+}  // namespace
+
+/**
+ * @brief Default constructor. There are no deadlines until Start() is
+ *        called
+ */
+TimeManager::TimeManager()
+    : hard_deadline_(kNoDeadline),
+      hard_limit_(),
+      soft_deadline_(kNoDeadline),
+      soft_limit_(),
+      start_(Now()) {
+}
+
+/**
+ * @brief Get the time since the search started
+ *
+ * @return The elapsed time, in milliseconds
+ */
+std::int64_t TimeManager::Elapsed() const noexcept {
+    const auto ticks = Clock::duration(Now() - start_.load());
+
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        ticks).count();
+}
+
+/**
+ * @brief Get the time allowed before the hard deadline
+ *
+ * @return The hard limit in milliseconds, or nothing if the search is not
+ *         timed
+ */
+std::optional<std::int64_t> TimeManager::HardLimit() const noexcept {
+    return hard_limit_;
+}
+
+/**
+ * @brief Check whether the search must stop
+ *
+ * @return True if the hard deadline has passed
+ */
+bool TimeManager::HardLimitReached() const noexcept {
+    return Now() >= hard_deadline_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Switch from pondering to a normal search. Our clock has started,
+ *        so the deadlines are counted from now
+ */
+void TimeManager::PonderHit() noexcept {
+    SetDeadlines(Now());
+}
+
+/**
+ * @brief Get the time allowed before the soft deadline
+ *
+ * @return The soft limit in milliseconds, or nothing if the search is not
+ *         timed
+ */
+std::optional<std::int64_t> TimeManager::SoftLimit() const noexcept {
+    return soft_limit_;
+}
+
+/**
+ * @brief Check whether the search should avoid starting new work
+ *
+ * @return True if the soft deadline has passed
+ */
+bool TimeManager::SoftLimitReached() const noexcept {
+    return Now() >= soft_deadline_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Compute the deadlines for a new search
+ *
+ * With "movetime", both deadlines are the given time. With a clock, the
+ * soft limit is an even share of the remaining time over the moves left to
+ * the next time control, plus most of the increment. The hard limit allows
+ * overrunning that by up to \ref kHardLimitFactor times, but never beyond
+ * the time left. A few milliseconds per move are always held back
+ *
+ * @note Not safe to call while a search is running
+ *
+ * @param limits The parameters of the "go" command
+ * @param player The player to move
+ */
+void TimeManager::Start(const SearchLimits& limits, Player player) noexcept {
+    const auto& time = player == Player::kWhite ? limits.wtime : limits.btime;
+    const auto& inc  = player == Player::kWhite ? limits.winc  : limits.binc;
+
+    soft_limit_.reset();
+    hard_limit_.reset();
+
+    if (limits.infinite) {
+        // No limits
+    } else if (limits.movetime) {
+        const std::int64_t budget =
+            std::max<std::int64_t>(*limits.movetime - kMoveOverhead, 1);
+
+        soft_limit_ = budget;
+        hard_limit_ = budget;
+    } else if (time) {
+        const std::int64_t available =
+            std::max<std::int64_t>(*time - kMoveOverhead, 1);
+
+        const int moves_to_go = limits.movestogo ?
+            std::clamp(*limits.movestogo, 1, 50) : kDefaultMovesToGo;
+
+        const std::int64_t soft = std::clamp<std::int64_t>(
+            available / moves_to_go + inc.value_or(0) * 3 / 4,
+            1, available);
+
+        soft_limit_ = soft;
+        hard_limit_ = std::min(available, soft * kHardLimitFactor);
+    }
+
+    const Clock::rep now = Now();
+
+    start_ = now;
+
+    if (limits.ponder) {
+        soft_deadline_ = kNoDeadline;
+        hard_deadline_ = kNoDeadline;
+    } else {
+        SetDeadlines(now);
+    }
+}
+
+/**
+ * @brief Get the current time
+ *
+ * @return The time, in clock ticks
+ */
+auto TimeManager::Now() noexcept -> Clock::rep {
+    return Clock::now().time_since_epoch().count();
+}
+
+/**
+ * @brief Set the deadlines relative to a start time
+ *
+ * @param start The start time, in clock ticks
+ */
+void TimeManager::SetDeadlines(Clock::rep start) noexcept {
+    soft_deadline_ = soft_limit_ ? start + ToTicks(*soft_limit_) :
+                                   kNoDeadline;
+    hard_deadline_ = hard_limit_ ? start + ToTicks(*hard_limit_) :
+                                   kNoDeadline;
+}
+
+}  // namespace chess
@@ -0,0 +1,260 @@
+/**
+ *  \file   transposition_table.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include "chess/transposition_table.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace chess {
+namespace {
+/*
+ * Layout of the packed data word:
+ *
+ * bits  0-20: move
+ * bits 21-36: score
+ * bits 37-44: depth
+ * bits 45-46: bound
+ * bits 47-52: generation
+ */
+constexpr int kScoreShift      = 21;
+constexpr int kDepthShift      = 37;
+constexpr int kBoundShift      = 45;
+constexpr int kGenerationShift = 47;
+
+constexpr std::uint64_t kMoveMask       = 0x1fffff;
+constexpr std::uint8_t  kGenerationMask = 0x3f;
+
+/**
+ * The number of slots inspected by TranspositionTable::HashFull()
+ */
+constexpr std::size_t kHashFullSamples = 1000;
+
+constexpr std::uint64_t Pack(std::uint32_t move, int score, int depth,
+                             Bound bound, std::uint8_t generation) noexcept {
+    return (move & kMoveMask) |
+        (std::uint64_t(std::uint16_t(score)) << kScoreShift) |
+        (std::uint64_t(std::uint8_t(depth))  << kDepthShift) |
+        (std::uint64_t(bound)                << kBoundShift) |
+        (std::uint64_t(generation)           << kGenerationShift);
+}
+
+constexpr std::uint32_t UnpackMove(std::uint64_t data) noexcept {
+    return static_cast<std::uint32_t>(data & kMoveMask);
+}
+
+constexpr std::int16_t UnpackScore(std::uint64_t data) noexcept {
+    return static_cast<std::int16_t>(data >> kScoreShift);
+}
+
+constexpr std::int8_t UnpackDepth(std::uint64_t data) noexcept {
+    return static_cast<std::int8_t>(data >> kDepthShift);
+}
+
+constexpr Bound UnpackBound(std::uint64_t data) noexcept {
+    return static_cast<Bound>((data >> kBoundShift) & 0x3);
+}
+
+constexpr std::uint8_t UnpackGeneration(std::uint64_t data) noexcept {
+    return static_cast<std::uint8_t>(data >> kGenerationShift) &
+        kGenerationMask;
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor
+ *
+ * @param megabytes The maximum table size, in megabytes
+ */
+TranspositionTable::TranspositionTable(std::size_t megabytes)
+    : buckets_(), mask_(0), generation_(0) {
+    Resize(megabytes);
+}
+
+/**
+ * @brief Erase all entries
+ *
+ * @note Not safe to call while other threads are probing the table
+ */
+void TranspositionTable::Clear() noexcept {
+    for (std::size_t i = 0; i <= mask_; i++) {
+        for (auto& slot : buckets_[i].slots) {
+            slot.check.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    generation_ = 0;
+}
+
+/**
+ * @brief Estimate how full the table is, as used by the UCI "hashfull"
+ *        info field
+ *
+ * Only entries written during the current search are counted, and only the
+ * first \ref kHashFullSamples slots are inspected, so this is cheap enough to
+ * call while searching
+ *
+ * @return The table occupancy, in permille
+ */
+int TranspositionTable::HashFull() const noexcept {
+    const std::size_t n_buckets =
+        std::min(kHashFullSamples / kBucketSize, mask_ + 1);
+
+    std::size_t used = 0;
+
+    for (std::size_t i = 0; i < n_buckets; i++) {
+        for (const auto& slot : buckets_[i].slots) {
+            const std::uint64_t data =
+                slot.data.load(std::memory_order_relaxed);
+
+            if (UnpackBound(data) != Bound::kNone &&
+                UnpackGeneration(data) == generation_) {
+                used++;
+            }
+        }
+    }
+
+    return static_cast<int>(used * 1000 / (n_buckets * kBucketSize));
+}
+
+/**
+ * @brief Signal the start of a new search. Entries from previous searches
+ *        become preferred candidates for replacement
+ *
+ * @note Not safe to call while other threads are storing to the table
+ */
+void TranspositionTable::NewSearch() noexcept {
+    generation_ = (generation_ + 1) & kGenerationMask;
+}
+
+/**
+ * @brief Look up a position
+ *
+ * @param[in]  key   The position's hash key
+ * @param[out] entry The stored entry, if found
+ *
+ * @return True if an entry for \a key was found
+ */
+bool TranspositionTable::Probe(std::uint64_t key,
+                               Entry* entry) const noexcept {
+    for (const auto& slot : BucketFor(key).slots) {
+        const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+        const std::uint64_t check =
+            slot.check.load(std::memory_order_relaxed);
+
+        if ((check ^ data) == key && UnpackBound(data) != Bound::kNone) {
+            entry->move  = UnpackMove(data);
+            entry->score = UnpackScore(data);
+            entry->depth = UnpackDepth(data);
+            entry->bound = UnpackBound(data);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Reallocate the table. All entries are lost
+ *
+ * @param megabytes The maximum table size, in megabytes. The actual size is
+ *                  rounded down to a power of two number of buckets
+ */
+void TranspositionTable::Resize(std::size_t megabytes) {
+    const std::size_t max_buckets =
+        std::max<std::size_t>(megabytes * 1024 * 1024 / sizeof(Bucket), 1);
+
+    std::size_t n_buckets = 1;
+    while (n_buckets * 2 <= max_buckets) n_buckets *= 2;
+
+    buckets_.reset(new Bucket[n_buckets]);
+    mask_ = n_buckets - 1;
+
+    Clear();
+}
+
+/**
+ * @brief Get the size of the table
+ *
+ * @return The table size, in bytes
+ */
+std::size_t TranspositionTable::Size() const noexcept {
+    return (mask_ + 1) * sizeof(Bucket);
+}
+
+/**
+ * @brief Record a search result
+ *
+ * If \a key is already in the table, its entry is overwritten unless the
+ * existing entry came from a deeper search this generation and the new
+ * result is not exact. Otherwise the slot holding the shallowest, oldest
+ * entry in the bucket is replaced
+ *
+ * @param key   The position's hash key
+ * @param move  The best move, or 0 if none. If 0, any move previously stored
+ *              for \a key is kept
+ * @param score The search score
+ * @param depth The depth searched
+ * @param bound The type of bound \a score represents
+ */
+void TranspositionTable::Store(std::uint64_t key, std::uint32_t move,
+                               int score, int depth, Bound bound) noexcept {
+    Bucket& bucket = BucketFor(key);
+
+    Slot* replace = nullptr;
+    int replace_value = 0;
+
+    for (auto& slot : bucket.slots) {
+        const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+        const std::uint64_t check =
+            slot.check.load(std::memory_order_relaxed);
+
+        const int age = (generation_ - UnpackGeneration(data)) &
+            kGenerationMask;
+
+        if ((check ^ data) == key && UnpackBound(data) != Bound::kNone) {
+            if (bound != Bound::kExact && age == 0 &&
+                depth < UnpackDepth(data)) {
+                return;
+            }
+
+            if (move == 0) move = UnpackMove(data);
+
+            replace = &slot;
+            break;
+        }
+
+        const int value = UnpackBound(data) == Bound::kNone ?
+            std::numeric_limits<int>::min() : UnpackDepth(data) - 8 * age;
+
+        if (replace == nullptr || value < replace_value) {
+            replace = &slot;
+            replace_value = value;
+        }
+    }
+
+    const std::uint64_t data =
+        Pack(move, score, depth, bound, generation_);
+
+    replace->check.store(key ^ data, std::memory_order_relaxed);
+    replace->data.store(data, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the bucket a key maps to
+ *
+ * @param key The position's hash key
+ *
+ * @return The bucket in which \a key may be stored
+ */
+auto TranspositionTable::BucketFor(std::uint64_t key) const noexcept
+        -> Bucket& {
+    return buckets_[key & mask_];
+}
+
+}  // namespace chess
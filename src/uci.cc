@@ -6,11 +6,56 @@
 
 #include "chess/uci.h"
 
+#include <charconv>
+#include <optional>
+#include <string>
 #include <vector>
 
 #include "superstring/superstring.h"
 
 namespace chess {
+namespace {
+/**
+ * @brief Parse an integer argument
+ *
+ * @param[in]  token The text to parse
+ * @param[out] value The parsed value
+ *
+ * @return True if all of \a token was parsed
+ */
+template <typename T>
+bool ParseInteger(const std::string& token, std::optional<T>* value) {
+    T result;
+
+    const char* end = token.data() + token.size();
+
+    const auto [ptr, error] = std::from_chars(token.data(), end, result);
+
+    if (error != std::errc() || ptr != end) return false;
+
+    *value = result;
+    return true;
+}
+
+/**
+ * @brief Check whether a token is one of the "go" command parameters
+ *
+ * @param token The token to check
+ *
+ * @return True if \a token names a parameter
+ */
+bool IsGoParameter(const std::string& token) {
+    for (const char* name : {"searchmoves", "ponder", "wtime", "btime",
+                             "winc", "binc", "movestogo", "depth", "nodes",
+                             "mate", "movetime", "infinite"}) {
+        if (token == name) return true;
+    }
+
+    return false;
+}
+
+}  // namespace
+
 /**
  * @brief Constructor
  *
@@ -167,10 +212,88 @@ bool UciProtocol::HandlePositionCommand(const std::vector<std::string>& args) {
 /**
  * @brief Forwards the "go" command to the engine
  *
+ * A search is always started, since the GUI waits for "bestmove". Any
+ * arguments that cannot be parsed are logged and ignored
+ *
+ * @param args The search parameters
+ *
  * @return True on success
  */
-bool UciProtocol::HandleGoCommand(const std::vector<std::string>& ) {
-    engine_->Go(); return true;
+bool UciProtocol::HandleGoCommand(const std::vector<std::string>& args) {
+    engine_->Go(ParseGoCommand(args)); return true;
+}
+
+/**
+ * @brief Parse the arguments to the "go" command. Unknown parameters, and
+ *        parameters without a valid value, are logged and skipped
+ *
+ * @param args The command arguments
+ *
+ * @return The search limits that were parsed
+ */
+SearchLimits UciProtocol::ParseGoCommand(
+        const std::vector<std::string>& args) {
+    SearchLimits limits;
+
+    for (std::size_t i = 0; i < args.size(); i++) {
+        const std::string& name = args[i];
+
+        if (name == "infinite") {
+            limits.infinite = true;
+            continue;
+        } else if (name == "ponder") {
+            limits.ponder = true;
+            continue;
+        } else if (name == "searchmoves") {
+            while (i+1 < args.size() && !IsGoParameter(args[i+1])) {
+                limits.searchmoves.push_back(args[++i]);
+            }
+            continue;
+        } else if (!IsGoParameter(name)) {
+            logger_->Write("HandleGoCommand: unknown parameter '%s'.\n",
+                           name.c_str());
+            continue;
+        }
+
+        // Leave the next parameter alone if this one's value is missing
+
+        if (i+1 >= args.size() || IsGoParameter(args[i+1])) {
+            logger_->Write("HandleGoCommand: '%s' requires a value.\n",
+                           name.c_str());
+            continue;
+        }
+
+        const std::string& value = args[++i];
+
+        bool valid = true;
+
+        if (name == "wtime") {
+            valid = ParseInteger(value, &limits.wtime);
+        } else if (name == "btime") {
+            valid = ParseInteger(value, &limits.btime);
+        } else if (name == "winc") {
+            valid = ParseInteger(value, &limits.winc);
+        } else if (name == "binc") {
+            valid = ParseInteger(value, &limits.binc);
+        } else if (name == "movestogo") {
+            valid = ParseInteger(value, &limits.movestogo);
+        } else if (name == "depth") {
+            valid = ParseInteger(value, &limits.depth);
+        } else if (name == "nodes") {
+            valid = ParseInteger(value, &limits.nodes);
+        } else if (name == "mate") {
+            valid = ParseInteger(value, &limits.mate);
+        } else if (name == "movetime") {
+            valid = ParseInteger(value, &limits.movetime);
+        }
+
+        if (!valid) {
+            logger_->Write("HandleGoCommand: ignoring invalid %s '%s'.\n",
+                           name.c_str(), value.c_str());
+        }
+    }
+
+    return limits;
 }
 
 /**
@@ -0,0 +1,174 @@
+/**
+ *  \file   alpha_beta_ut.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chess/alpha_beta.h"
+#include "chess/logger.h"
+#include "chess/null_stream_channel.h"
+#include "chess/position.h"
+#include "chess/transposition_table.h"
+#include "chess/util.h"
+
+namespace {
+/**
+ * Records the UCI output of a search
+ */
+class StringChannel final : public chess::OutputStreamChannel {
+public:
+    void Flush() noexcept override {
+    }
+
+    void Write(const chess::ConstDataBuffer& buffer) noexcept override {
+        output.append(buffer.data(), buffer.size());
+    }
+
+    std::string output;
+};
+
+/**
+ * @brief Create a search with a small transposition table
+ *
+ * @return The new search
+ */
+std::shared_ptr<chess::AlphaBeta> MakeSearch() {
+    auto channel = std::make_shared<chess::NullOstreamChannel>();
+    auto logger = std::make_shared<chess::Logger>("alpha_beta", channel);
+
+    return std::make_shared<chess::AlphaBeta>(
+        std::make_shared<chess::TranspositionTable>(16), logger);
+}
+
+/**
+ * @brief Run a search and return the best move in long algebraic notation
+ *
+ * @param search The search to run
+ * @param fen    The root position
+ *
+ * @return The selected move
+ */
+std::string BestMove(chess::AlphaBeta* search, const std::string& fen) {
+    chess::Position pos;
+    EXPECT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess);
+
+    return chess::util::ToLongAlgebraic(search->Run(pos));
+}
+
+TEST(alpha_beta, mate_in_one) {
+    auto search = MakeSearch();
+    search->SetMaxDepth(4);
+
+    EXPECT_EQ(BestMove(search.get(), "6nk/6pp/7N/8/8/8/8/7K w - - 0 1"),
+              "h6f7 ");
+    EXPECT_EQ(search->Score(), chess::AlphaBeta::kMateScore - 1);
+
+    EXPECT_EQ(BestMove(search.get(), "r5k1/8/8/8/8/8/5PPP/6K1 b - - 0 1"),
+              "a8a1 ");
+    EXPECT_EQ(search->Score(), chess::AlphaBeta::kMateScore - 1);
+}
+
+TEST(alpha_beta, mate_in_two) {
+    auto search = MakeSearch();
+    search->SetMaxDepth(6);
+
+    // 1. Ra7 Kg8 2. Rb8#
+    BestMove(search.get(), "7k/8/8/8/8/8/R7/1R4K1 w - - 0 1");
+
+    EXPECT_EQ(search->Score(), chess::AlphaBeta::kMateScore - 3);
+
+    const std::vector<std::uint32_t> pv = search->PrincipalVariation();
+    ASSERT_EQ(pv.size(), 3u);
+}
+
+TEST(alpha_beta, wins_material) {
+    auto search = MakeSearch();
+    search->SetMaxDepth(4);
+
+    // Knight fork of king and rook
+    EXPECT_EQ(BestMove(search.get(), "r3k3/8/8/1N6/8/8/8/4K3 w - - 0 1"),
+              "b5c7 ");
+
+    // Don't take a defended pawn with the queen
+    EXPECT_NE(BestMove(search.get(), "4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1"),
+              "d1d5 ");
+}
+
+TEST(alpha_beta, game_over) {
+    auto search = MakeSearch();
+
+    // Stalemate
+    EXPECT_EQ(BestMove(search.get(), "7k/5Q2/8/8/8/8/8/6K1 b - - 0 1"),
+              chess::util::ToLongAlgebraic(chess::kNullMove));
+
+    // Checkmate
+    EXPECT_EQ(BestMove(search.get(), "R5k1/5ppp/8/8/8/8/8/6K1 b - - 0 1"),
+              chess::util::ToLongAlgebraic(chess::kNullMove));
+}
+
+TEST(alpha_beta, limits) {
+    auto search = MakeSearch();
+    search->SetMaxDepth(3);
+
+    const std::string fen(chess::Position::kDefaultFen);
+
+    EXPECT_NE(BestMove(search.get(), fen),
+              chess::util::ToLongAlgebraic(chess::kNullMove));
+    EXPECT_EQ(search->Depth(), 3);
+
+    const std::uint64_t nodes = search->Nodes();
+    EXPECT_GT(nodes, 0u);
+
+    // A node limit stops the search early but still yields a legal move
+
+    search->SetMaxDepth(64);
+    search->SetMaxNodes(nodes);
+
+    EXPECT_NE(BestMove(search.get(), fen),
+              chess::util::ToLongAlgebraic(chess::kNullMove));
+    EXPECT_LE(search->Nodes(), nodes);
+}
+
+TEST(alpha_beta, info) {
+    auto search = MakeSearch();
+    auto channel = std::make_shared<StringChannel>();
+
+    search->SetInfoChannel(channel);
+    search->SetMaxDepth(3);
+
+    chess::Position pos;
+    pos.Reset();
+
+    ASSERT_NE(search->Run(pos), chess::kNullMove);
+
+    // One report per completed iteration
+
+    for (const std::string depth : {"1", "2", "3"}) {
+        const std::string line = "info depth " + depth + " seldepth ";
+        EXPECT_NE(channel->output.find(line), std::string::npos) << line;
+    }
+
+    EXPECT_EQ(channel->output.find("info depth 4"), std::string::npos);
+    EXPECT_NE(channel->output.find(" nps "), std::string::npos);
+    EXPECT_NE(channel->output.find(" hashfull "), std::string::npos);
+
+    // Mate scores are reported in moves
+
+    channel->output.clear();
+
+    EXPECT_EQ(BestMove(search.get(), "6nk/6pp/7N/8/8/8/8/7K w - - 0 1"),
+              "h6f7 ");
+    EXPECT_NE(channel->output.find("score mate 1 "), std::string::npos)
+        << channel->output;
+    EXPECT_NE(channel->output.find(" pv h6f7\n"), std::string::npos)
+        << channel->output;
+}
+
+}  // namespace
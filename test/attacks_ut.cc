@@ -0,0 +1,48 @@
+/**
+ *  \file   attacks_ut.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <cstdint>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "chess/attacks.h"
+#include "chess/chess.h"
+#include "chess/data_tables.h"
+
+namespace {
+TEST(attacks, sliders) {
+    // Whichever lookup method is in use must agree with the slow reference
+    // implementation
+
+    std::mt19937_64 rng(2026);
+
+    for (int square = 0; square < 64; square++) {
+        for (int i = 0; i < 1000; i++) {
+            const std::uint64_t occupied = rng() & rng();
+
+            const auto from = static_cast<chess::Square>(square);
+
+            EXPECT_EQ(chess::AttacksFrom<chess::Piece::BISHOP>(from, occupied),
+                      chess::data_tables::internal::AttacksFromDiag(
+                          square, occupied));
+            EXPECT_EQ(chess::AttacksFrom<chess::Piece::ROOK>(from, occupied),
+                      chess::data_tables::internal::AttacksFromRook(
+                          square, occupied));
+        }
+    }
+}
+
+TEST(attacks, pext) {
+    if (!chess::detail::UsePext()) GTEST_SKIP() << "PEXT is not in use";
+
+    EXPECT_EQ(chess::detail::Pext(0xf0f0, 0xff00), 0xf0u);
+    EXPECT_EQ(chess::detail::Pext(0x8000000000000001, 0x8000000000000001),
+              0x3u);
+    EXPECT_EQ(chess::detail::Pext(0x1234, 0), 0u);
+}
+
+}  // namespace
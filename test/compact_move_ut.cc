@@ -0,0 +1,135 @@
+/**
+ *  \file   compact_move_ut.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+#include "chess/chess.h"
+#include "chess/compact_move.h"
+#include "chess/movegen.h"
+#include "chess/position.h"
+#include "chess/scored_move_list.h"
+#include "chess/util.h"
+
+namespace {
+/**
+ * Positions with castling, en passant, promotions and captures that promote
+ */
+constexpr const char* kFens[] = {
+    chess::Position::kDefaultFen,
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/Pp2P3/2N2Q1p/1PPBBPPP/R3K2R b KQkq a3 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "2r5/1P6/8/8/8/8/1p6/2R1K2k b - - 0 1"
+};
+
+/**
+ * @brief Check that every legal move survives a round trip through the
+ *        compact format
+ *
+ * @param pos The position to generate moves for
+ */
+template <chess::Player P>
+void CheckRoundTrip(const chess::Position& pos) {
+    std::array<std::uint32_t, chess::kMaxMoves> moves;
+
+    const std::size_t n_moves = pos.InCheck<P>() ?
+        chess::GenerateCheckEvasions<P>(pos, moves.data()) :
+        chess::GenerateLegalMoves<P>(pos, moves.data());
+
+    ASSERT_GT(n_moves, 0u);
+
+    for (std::size_t i = 0; i < n_moves; i++) {
+        const auto compact = chess::CompactMove::FromPacked(moves[i]);
+
+        EXPECT_EQ(compact.From(), chess::util::ExtractFrom(moves[i]));
+        EXPECT_EQ(compact.To(), chess::util::ExtractTo(moves[i]));
+        EXPECT_EQ(compact.Promoted(), chess::util::ExtractPromoted(moves[i]));
+        EXPECT_EQ(compact.IsCapture(),
+                  chess::util::ExtractCaptured(moves[i]) !=
+                      chess::Piece::EMPTY);
+
+        EXPECT_EQ(compact.ToPacked(pos), moves[i])
+            << chess::util::ToLongAlgebraic(moves[i]);
+
+        EXPECT_EQ(chess::CompactMove(compact.Data()), compact);
+    }
+}
+
+TEST(compact_move, null) {
+    constexpr chess::CompactMove null;
+
+    static_assert(null.IsNull());
+    static_assert(chess::CompactMove::FromPacked(chess::kNullMove).IsNull());
+
+    chess::Position pos;
+    EXPECT_EQ(null.ToPacked(pos), chess::kNullMove);
+}
+
+TEST(compact_move, round_trip) {
+    for (const char* fen : kFens) {
+        chess::Position pos;
+        ASSERT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess) << fen;
+
+        if (pos.ToMove() == chess::Player::kWhite) {
+            CheckRoundTrip<chess::Player::kWhite>(pos);
+        } else {
+            CheckRoundTrip<chess::Player::kBlack>(pos);
+        }
+    }
+}
+
+TEST(scored_move_list, pick_best) {
+    chess::ScoredMoveList list;
+
+    constexpr std::int32_t kScores[] = {3, -1, 7, 3, 0};
+    constexpr std::size_t kSize = sizeof(kScores) / sizeof(kScores[0]);
+
+    for (std::size_t i = 0; i < kSize; i++) {
+        list.Data()[i] = static_cast<std::uint32_t>(i + 1);
+    }
+
+    list.Resize(kSize);
+
+    for (std::size_t i = 0; i < kSize; i++) list.Score(i) = kScores[i];
+
+    EXPECT_EQ(list.PickBest(0), 3u);
+    EXPECT_EQ(list.PickBest(1), 1u);
+    EXPECT_EQ(list.PickBest(2), 4u);
+    EXPECT_EQ(list.PickBest(3), 5u);
+    EXPECT_EQ(list.PickBest(4), 2u);
+}
+
+TEST(scored_move_list, sort) {
+    chess::ScoredMoveList list;
+
+    constexpr std::int32_t kScores[] = {3, -1, 7, 3, 0};
+    constexpr std::size_t kSize = sizeof(kScores) / sizeof(kScores[0]);
+
+    list.Resize(kSize);
+
+    for (std::size_t i = 0; i < kSize; i++) {
+        list.Move(i)  = static_cast<std::uint32_t>(i + 1);
+        list.Score(i) = kScores[i];
+    }
+
+    list.Sort();
+
+    // Equal scores keep their order
+
+    constexpr std::uint32_t kExpected[] = {3, 1, 4, 5, 2};
+
+    for (std::size_t i = 0; i < kSize; i++) {
+        EXPECT_EQ(list.Move(i), kExpected[i]);
+    }
+}
+
+}  // namespace
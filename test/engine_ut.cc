@@ -0,0 +1,150 @@
+/**
+ *  \file   engine_ut.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "chess/engine.h"
+#include "chess/logger.h"
+#include "chess/null_stream_channel.h"
+
+namespace {
+/**
+ * Records everything the engine sends to the GUI
+ */
+class CaptureChannel final : public chess::OutputStreamChannel {
+public:
+    void Flush() noexcept override {
+    }
+
+    void Write(const chess::ConstDataBuffer& buffer) noexcept override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        output_.append(buffer.data(), buffer.size());
+    }
+
+    std::string Output() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return output_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::string output_;
+};
+
+std::size_t Count(const std::string& text, const std::string& pattern) {
+    std::size_t count = 0;
+
+    for (auto pos = text.find(pattern); pos != std::string::npos;
+         pos = text.find(pattern, pos + 1)) {
+        count++;
+    }
+
+    return count;
+}
+
+TEST(engine, isready_during_search) {
+    auto channel = std::make_shared<CaptureChannel>();
+    auto logger = std::make_shared<chess::Logger>(
+        "engine", std::make_shared<chess::NullOstreamChannel>());
+
+    chess::Engine engine(channel, logger);
+
+    // Go returns right away, leaving the search running
+
+    engine.Go(chess::SearchLimits());
+
+    EXPECT_TRUE(engine.IsReady());
+
+    engine.Stop();
+
+    const std::string output = channel->Output();
+
+    const auto readyok = output.find("readyok");
+    const auto bestmove = output.find("bestmove ");
+
+    ASSERT_NE(readyok, std::string::npos);
+    ASSERT_NE(bestmove, std::string::npos);
+    EXPECT_LT(readyok, bestmove);
+    EXPECT_EQ(Count(output, "bestmove "), 1u);
+}
+
+TEST(engine, stop) {
+    auto channel = std::make_shared<CaptureChannel>();
+    auto logger = std::make_shared<chess::Logger>(
+        "engine", std::make_shared<chess::NullOstreamChannel>());
+
+    chess::Engine engine(channel, logger);
+
+    // Stopping with no search in progress does nothing
+
+    engine.Stop();
+    EXPECT_EQ(Count(channel->Output(), "bestmove "), 0u);
+
+    // A new search or position finishes the previous search first, and every
+    // search sends exactly one bestmove
+
+    engine.Go(chess::SearchLimits());
+    engine.Go(chess::SearchLimits());
+    ASSERT_TRUE(engine.Position({"startpos", "moves", "e2e4"}));
+
+    EXPECT_EQ(Count(channel->Output(), "bestmove "), 2u);
+
+    engine.DebugMode(true);
+    engine.Go(chess::SearchLimits());
+    engine.Stop();
+
+    const std::string output = channel->Output();
+
+    EXPECT_EQ(Count(output, "bestmove "), 3u);
+    EXPECT_EQ(Count(output, "info string stop latency"), 1u);
+}
+
+TEST(engine, movetime) {
+    auto channel = std::make_shared<CaptureChannel>();
+    auto logger = std::make_shared<chess::Logger>(
+        "engine", std::make_shared<chess::NullOstreamChannel>());
+
+    chess::Engine engine(channel, logger);
+
+    chess::SearchLimits limits;
+    limits.movetime = 200;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    engine.Go(limits);
+
+    // The search ends by itself once its time is up
+
+    while (Count(channel->Output(), "bestmove ") == 0u) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        ASSERT_LT(std::chrono::steady_clock::now() - start,
+                  std::chrono::seconds(5));
+    }
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(100));
+
+    // An infinite search waits for "stop"
+
+    limits = chess::SearchLimits();
+    limits.infinite = true;
+
+    engine.Go(limits);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_EQ(Count(channel->Output(), "bestmove "), 1u);
+
+    engine.Stop();
+    EXPECT_EQ(Count(channel->Output(), "bestmove "), 2u);
+}
+
+}  // namespace
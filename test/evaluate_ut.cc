@@ -0,0 +1,172 @@
+/**
+ *  \file   evaluate_ut.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "chess/chess.h"
+#include "chess/evaluate.h"
+#include "chess/movegen.h"
+#include "chess/position.h"
+#include "chess/util.h"
+
+namespace {
+/**
+ * Positions with castling, en passant, promotions and captures that promote
+ */
+constexpr const char* kFens[] = {
+    chess::Position::kDefaultFen,
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/Pp2P3/2N2Q1p/1PPBBPPP/R3K2R b KQkq a3 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"
+};
+
+/**
+ * @brief Mirror a position top to bottom and swap the colors of all pieces
+ *
+ * @param fen The position, without castling rights or en passant target
+ *
+ * @return The same position with the roles of White and Black reversed
+ */
+std::string Mirror(const std::string& fen) {
+    const std::size_t space = fen.find(' ');
+
+    std::string board;
+
+    for (std::size_t end = space; end != std::string::npos; ) {
+        const std::size_t begin = fen.rfind('/', end-1);
+        const std::size_t start = begin == std::string::npos ? 0 : begin+1;
+
+        if (!board.empty()) board += '/';
+        board += fen.substr(start, end - start);
+
+        end = begin;
+    }
+
+    for (char& c : board) {
+        c = std::isupper(c) ? std::tolower(c) : std::toupper(c);
+    }
+
+    const char to_move = fen[space+1] == 'w' ? 'b' : 'w';
+
+    return board + " " + to_move + fen.substr(space+2);
+}
+
+/**
+ * @brief Check that the incrementally updated material and piece-square sums
+ *        agree with a position set up from scratch, after every move of a
+ *        tree and again once each move is taken back
+ *
+ * @param pos   The position to search from
+ * @param depth The remaining depth
+ */
+template <chess::Player P>
+void CheckIncremental(chess::Position* pos, int depth) {
+    chess::Position scratch;
+    ASSERT_EQ(scratch.Reset(pos->GetFen()),
+              chess::Position::FenError::kSuccess);
+
+    ASSERT_TRUE(*pos == scratch) << pos->GetFen();
+    ASSERT_EQ(chess::Evaluate<P>(*pos), chess::Evaluate<P>(scratch));
+
+    if (depth == 0) return;
+
+    std::array<std::uint32_t, chess::kMaxMoves> moves;
+
+    const std::size_t n_moves = pos->InCheck<P>() ?
+        chess::GenerateCheckEvasions<P>(*pos, moves.data()) :
+        chess::GenerateLegalMoves<P>(*pos, moves.data());
+
+    const chess::Position before(*pos);
+
+    for (std::size_t i = 0; i < n_moves; i++) {
+        chess::Position::UndoInfo undo;
+        pos->MakeMove<P>(moves[i], &undo);
+
+        CheckIncremental<chess::util::opponent<P>()>(pos, depth-1);
+
+        pos->UnMakeMove<P>(moves[i], undo);
+
+        ASSERT_TRUE(*pos == before) << chess::util::ToLongAlgebraic(moves[i]);
+    }
+}
+
+TEST(evaluate, start_position) {
+    chess::Position pos;
+    pos.Reset();
+
+    EXPECT_EQ(chess::Evaluate<chess::Player::kWhite>(pos), 0);
+    EXPECT_EQ(chess::Evaluate<chess::Player::kBlack>(pos), 0);
+    EXPECT_EQ(chess::Evaluate(pos), 0);
+}
+
+TEST(evaluate, terms) {
+    chess::Position pos;
+
+    // A centralized knight against one in the corner
+    ASSERT_EQ(pos.Reset("n3k3/8/8/8/3N4/8/8/4K3 w - - 0 1"),
+              chess::Position::FenError::kSuccess);
+
+    EXPECT_EQ(pos.GetPlayerInfo<chess::Player::kWhite>().PieceSquare(), 30);
+    EXPECT_EQ(pos.GetPlayerInfo<chess::Player::kBlack>().PieceSquare(), 0);
+    EXPECT_EQ(chess::Evaluate<chess::Player::kWhite>(pos), 30);
+
+    // A pawn on the seventh rank
+    ASSERT_EQ(pos.Reset("4k3/1P6/8/8/8/8/8/4K3 b - - 0 1"),
+              chess::Position::FenError::kSuccess);
+
+    EXPECT_EQ(chess::Evaluate(pos), -(chess::kPawnValue + 70));
+
+    // A rook whose rank is cut short by its own king
+    ASSERT_EQ(pos.Reset("4k3/8/8/8/8/8/8/R3K3 w - - 0 1"),
+              chess::Position::FenError::kSuccess);
+
+    EXPECT_EQ(chess::SliderMobility<chess::Player::kWhite>(pos), 10);
+    EXPECT_EQ(chess::Evaluate(pos), chess::kRookValue + 10);
+}
+
+TEST(evaluate, symmetry) {
+    const char* fens[] = {
+        "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w - - 4 4",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "2r5/1P6/8/8/8/8/1p6/2R1K2k b - - 0 1",
+        "4k3/8/8/8/3N4/8/8/4K3 w - - 0 1"
+    };
+
+    for (const char* fen : fens) {
+        chess::Position pos, mirror;
+
+        ASSERT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess);
+        ASSERT_EQ(mirror.Reset(Mirror(fen)),
+                  chess::Position::FenError::kSuccess) << Mirror(fen);
+
+        EXPECT_EQ(chess::Evaluate<chess::Player::kWhite>(pos),
+                  chess::Evaluate<chess::Player::kBlack>(mirror)) << fen;
+        EXPECT_EQ(chess::Evaluate(pos), chess::Evaluate(mirror)) << fen;
+    }
+}
+
+TEST(evaluate, incremental) {
+    for (const char* fen : kFens) {
+        chess::Position pos;
+        ASSERT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess) << fen;
+
+        if (pos.ToMove() == chess::Player::kWhite) {
+            CheckIncremental<chess::Player::kWhite>(&pos, 2);
+        } else {
+            CheckIncremental<chess::Player::kBlack>(&pos, 2);
+        }
+    }
+}
+
+}  // namespace
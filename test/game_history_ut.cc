@@ -0,0 +1,135 @@
+/**
+ *  \file   game_history_ut.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chess/evaluate.h"
+#include "chess/game_history.h"
+#include "chess/interactive.h"
+#include "chess/position.h"
+
+namespace {
+/**
+ * @brief Play a sequence of moves, recording each position left behind
+ *
+ * @param pos     The position to play the moves in
+ * @param history Records the position before each move
+ * @param moves   The moves, in long algebraic notation
+ */
+void Play(chess::Position* pos, chess::GameHistory* history,
+          const std::vector<std::string>& moves) {
+    for (const auto& str : moves) {
+        const std::uint32_t move = chess::ResolveMove(*pos, str);
+        ASSERT_NE(move, chess::kNullMove) << str;
+
+        history->Push(pos->Hash());
+
+        chess::Position::UndoInfo undo;
+
+        pos->ToMove() == chess::Player::kWhite ?
+            pos->MakeMove<chess::Player::kWhite>(move, &undo) :
+            pos->MakeMove<chess::Player::kBlack>(move, &undo);
+    }
+}
+
+TEST(game_history, repetition) {
+    chess::Position pos;
+    pos.Reset();
+
+    chess::GameHistory history;
+
+    const std::vector<std::string> shuffle = {"g1f3", "g8f6", "f3g1", "f6g8"};
+
+    Play(&pos, &history, shuffle);
+
+    // The start position has now occurred twice. That is only a draw if
+    // the earlier occurrence is within the search
+
+    EXPECT_FALSE(history.IsRepetition(pos, 0));
+    EXPECT_FALSE(history.IsRepetition(pos, 4));
+    EXPECT_TRUE (history.IsRepetition(pos, 5));
+
+    Play(&pos, &history, shuffle);
+
+    EXPECT_TRUE(history.IsRepetition(pos, 0));
+    EXPECT_TRUE(history.IsDraw(pos, 0));
+
+    // Unwinding the last move takes the repetition back
+
+    history.Pop();
+    EXPECT_FALSE(history.IsRepetition(pos, 0));
+
+    history.Clear();
+    EXPECT_EQ(history.Size(), 0u);
+    EXPECT_FALSE(history.IsRepetition(pos, 0));
+}
+
+TEST(game_history, repetition_bounded_by_half_move_number) {
+    chess::Position pos;
+    ASSERT_EQ(pos.Reset("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1"),
+              chess::Position::FenError::kSuccess);
+
+    chess::GameHistory history;
+
+    // The same hash recorded before an irreversible move is ignored
+
+    for (int i = 0; i < 8; i++) history.Push(pos.Hash());
+
+    EXPECT_FALSE(history.IsRepetition(pos, 0));
+
+    ASSERT_EQ(pos.Reset("4k3/8/8/8/8/8/4P3/4K3 w - - 8 5"),
+              chess::Position::FenError::kSuccess);
+
+    EXPECT_TRUE(history.IsRepetition(pos, 0));
+}
+
+TEST(game_history, fifty_moves) {
+    chess::Position pos;
+    chess::GameHistory history;
+
+    ASSERT_EQ(pos.Reset("8/8/4k3/8/8/3K4/8/R7 w - - 99 80"),
+              chess::Position::FenError::kSuccess);
+    EXPECT_FALSE(history.IsDraw(pos, 1));
+
+    ASSERT_EQ(pos.Reset("8/8/4k3/8/8/3K4/8/R7 w - - 100 80"),
+              chess::Position::FenError::kSuccess);
+    EXPECT_TRUE(history.IsDraw(pos, 1));
+
+    // Checkmate on the hundredth ply stands
+
+    ASSERT_EQ(pos.Reset("R5k1/5ppp/8/8/8/8/8/6K1 b - - 100 80"),
+              chess::Position::FenError::kSuccess);
+    EXPECT_FALSE(history.IsDraw(pos, 1));
+}
+
+TEST(game_history, insufficient_material) {
+    const std::vector<std::pair<std::string, bool>> cases = {
+        {"8/8/4k3/8/8/3K4/8/8 w - - 0 1",   true},   // K v K
+        {"8/8/4k3/8/8/3K4/8/6N1 w - - 0 1", true},   // KN v K
+        {"8/8/4k3/8/8/3K4/8/5b2 w - - 0 1", true},   // K v KB
+        {"2b5/8/4k3/8/8/3K4/8/5B2 w - - 0 1", true}, // KB v KB, light
+        {"2b5/8/4k3/8/8/3K4/8/2B5 w - - 0 1", false},// KB v KB, mixed
+        {"8/8/4k3/8/8/3K4/8/5NN1 w - - 0 1", false}, // KNN v K
+        {"8/8/4k3/8/8/3K4/8/5BN1 w - - 0 1", false}, // KBN v K
+        {"8/8/4k3/8/8/3K4/4P3/8 w - - 0 1", false},  // KP v K
+        {"8/8/4k3/8/8/3K4/8/7R w - - 0 1",  false}   // KR v K
+    };
+
+    for (const auto& [fen, expected] : cases) {
+        chess::Position pos;
+        ASSERT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess) << fen;
+
+        EXPECT_EQ(chess::IsInsufficientMaterial(pos), expected) << fen;
+        EXPECT_EQ(chess::GameHistory().IsDraw(pos, 1), expected) << fen;
+    }
+}
+
+}  // namespace
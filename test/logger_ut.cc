@@ -27,19 +27,16 @@ TEST(logger, all) {
     const std::string expected("hello");
     const std::string name("Test");
 
-    auto check_message1 = [&](const chess::ConstDataBuffer& buffer) -> bool {
-        const std::string actual(buffer.data(), buffer.size());
-        return actual.find(name) != std::string::npos;
-    };
+    // The prefix and message are written together
 
-    auto check_message2 = [&](const chess::ConstDataBuffer& buffer) -> bool {
+    auto check_message = [&](const chess::ConstDataBuffer& buffer) -> bool {
         const std::string actual(buffer.data(), buffer.size());
-        return actual.find(expected) != std::string::npos;
+        return actual.find(name) != std::string::npos &&
+               actual.find(expected) != std::string::npos &&
+               actual.find(name) < actual.find(expected);
     };
 
-    EXPECT_CALL(*channel, Write(::testing::Truly(check_message1)))
-        .Times(1);
-    EXPECT_CALL(*channel, Write(::testing::Truly(check_message2)))
+    EXPECT_CALL(*channel, Write(::testing::Truly(check_message)))
         .Times(1);
     EXPECT_CALL(*channel, Flush())
         .Times(1);
@@ -253,4 +253,60 @@ TEST(MemoryPool, free_all) {
     ASSERT_EQ(pool.Allocate(), init_chunk);
 }
 
+TEST(MemoryPool, arrays) {
+    auto channel = std::make_shared<NullStreamChannel>();
+    channel->Resize(1024);
+
+    auto logger = std::make_shared<chess::Logger>("Test", channel);
+
+    constexpr std::size_t element_size = sizeof(MemoryChunk);
+    constexpr std::size_t n_elements = 100;
+
+    chess::MemoryPool<MemoryChunk> pool(n_elements * element_size, logger);
+
+    EXPECT_EQ(pool.Allocate(0), nullptr);
+    EXPECT_EQ(pool.Allocate(n_elements+1), nullptr);
+
+    // Arrays are carved from the front of the pool, back to back
+
+    MemoryChunk* first = pool.Allocate(30);
+    MemoryChunk* second = pool.Allocate(20);
+
+    ASSERT_NE(first, nullptr);
+    ASSERT_EQ(second, first + 30);
+    EXPECT_EQ(pool.InUse(), 50 * element_size);
+
+    // A freed array is reused by the next allocation of the same length
+
+    ASSERT_TRUE(pool.Free(first, 30));
+    EXPECT_EQ(pool.InUse(), 20 * element_size);
+    EXPECT_EQ(pool.Allocate(30), first);
+
+    // Once the front of the pool is used up, shorter arrays are split off
+    // longer free ones
+
+    ASSERT_EQ(pool.Allocate(50), second + 20);
+    EXPECT_TRUE(pool.Full());
+    EXPECT_EQ(pool.Allocate(), nullptr);
+
+    ASSERT_TRUE(pool.Free(first, 30));
+
+    MemoryChunk* head = pool.Allocate(10);
+    MemoryChunk* tail = pool.Allocate(20);
+
+    EXPECT_EQ(head, first);
+    EXPECT_EQ(tail, first + 10);
+    EXPECT_TRUE(pool.Full());
+
+    // Out of range arrays are rejected
+
+    EXPECT_FALSE(pool.Free(first + 90, 20));
+    EXPECT_FALSE(pool.Free(first, 0));
+
+    pool.Free();
+
+    EXPECT_EQ(pool.InUse(), 0u);
+    EXPECT_EQ(pool.Allocate(n_elements), first);
+}
+
 }  // namespace
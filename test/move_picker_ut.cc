@@ -0,0 +1,287 @@
+/**
+ *  \file   move_picker_ut.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chess/chess.h"
+#include "chess/move_picker.h"
+#include "chess/movegen.h"
+#include "chess/position.h"
+#include "chess/util.h"
+
+namespace {
+using History = chess::MovePicker<chess::Player::kWhite>::History;
+
+/**
+ * @brief Generate all legal moves
+ *
+ * @param pos The position to generate moves for
+ *
+ * @return The moves, in long algebraic notation, sorted
+ */
+template <chess::Player P>
+std::vector<std::string> LegalMoves(const chess::Position& pos) {
+    std::array<std::uint32_t, chess::kMaxMoves> moves;
+
+    const std::size_t n_moves = pos.InCheck<P>() ?
+        chess::GenerateCheckEvasions<P>(pos, moves.data()) :
+        chess::GenerateLegalMoves<P>(pos, moves.data());
+
+    std::vector<std::string> result;
+    for (std::size_t i = 0; i < n_moves; i++) {
+        result.push_back(chess::util::ToLongAlgebraic(moves[i]));
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/**
+ * @brief Look up a legal move from its long algebraic notation
+ *
+ * @param pos  The position to look in
+ * @param text The move, e.g. "e2e4 "
+ *
+ * @return The move, or kNullMove if it is not legal
+ */
+template <chess::Player P>
+std::uint32_t FindMove(const chess::Position& pos, const std::string& text) {
+    std::array<std::uint32_t, chess::kMaxMoves> moves;
+
+    const std::size_t n_moves = pos.InCheck<P>() ?
+        chess::GenerateCheckEvasions<P>(pos, moves.data()) :
+        chess::GenerateLegalMoves<P>(pos, moves.data());
+
+    for (std::size_t i = 0; i < n_moves; i++) {
+        if (chess::util::ToLongAlgebraic(moves[i]) == text) return moves[i];
+    }
+
+    return chess::kNullMove;
+}
+
+/**
+ * @brief Drain a picker
+ *
+ * @param picker The picker to drain
+ *
+ * @return The moves in the order they were returned
+ */
+template <chess::Player P>
+std::vector<std::string> Drain(chess::MovePicker<P>* picker) {
+    std::vector<std::string> result;
+
+    for (std::uint32_t move = picker->Next(); move != chess::kNullMove;
+         move = picker->Next()) {
+        result.push_back(chess::util::ToLongAlgebraic(move));
+    }
+
+    return result;
+}
+
+/**
+ * @brief Check that a picker returns every legal move exactly once, for a
+ *        few choices of hash move
+ *
+ * @param fen The position to test
+ */
+template <chess::Player P>
+void CheckAllMoves(const std::string& fen) {
+    chess::Position pos;
+    ASSERT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess);
+
+    const History history = {};
+    const std::vector<std::string> expected = LegalMoves<P>(pos);
+
+    std::vector<std::uint32_t> hash_moves = {chess::kNullMove};
+    for (const auto& text : expected) {
+        hash_moves.push_back(FindMove<P>(pos, text));
+    }
+
+    // A move which is not legal here, as if from a hash collision
+
+    hash_moves.push_back(chess::util::PackMove(
+        chess::Piece::EMPTY, chess::Square::A1, chess::Piece::QUEEN,
+        chess::Piece::EMPTY, chess::Square::H8));
+
+    for (std::uint32_t hash_move : hash_moves) {
+        const std::string before = pos.GetFen();
+
+        chess::MovePicker<P> picker(&pos, hash_move,
+                                    {chess::kNullMove, chess::kNullMove},
+                                    history);
+
+        std::vector<std::string> actual = Drain(&picker);
+
+        EXPECT_EQ(picker.GetStage(),
+                  chess::MovePicker<P>::Stage::kDone);
+        EXPECT_EQ(pos.GetFen(), before);
+
+        if (hash_move != chess::kNullMove && !actual.empty() &&
+            std::find(expected.begin(), expected.end(),
+                      chess::util::ToLongAlgebraic(hash_move)) !=
+                expected.end()) {
+            EXPECT_EQ(actual[0], chess::util::ToLongAlgebraic(hash_move));
+        }
+
+        std::sort(actual.begin(), actual.end());
+        EXPECT_EQ(actual, expected) << fen;
+    }
+}
+
+TEST(move_picker, all_moves) {
+    CheckAllMoves<chess::Player::kWhite>(chess::Position::kDefaultFen);
+
+    CheckAllMoves<chess::Player::kWhite>(
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+    CheckAllMoves<chess::Player::kBlack>(
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq - 0 1");
+
+    // Promotions and en passant
+
+    CheckAllMoves<chess::Player::kWhite>(
+        "n1n5/PPPk4/8/2pP4/8/8/4Kppp/5N1N w - c6 0 2");
+
+    // In check
+
+    CheckAllMoves<chess::Player::kBlack>(
+        "r1bqkbnr/pppp1Qpp/2n5/4p3/2B1P3/8/PPPP1PPP/RNB1K1NR b KQkq - 0 4");
+    CheckAllMoves<chess::Player::kWhite>(
+        "4k3/8/8/8/4r3/8/3P4/4K3 w - - 0 1");
+}
+
+TEST(move_picker, order) {
+    // Nxc6 trades knights, while Nxd5, Qxd5 and Rxa7 each give up a piece
+    // for a defended pawn
+
+    const std::string fen = "1k6/pp6/2n1p3/3p4/1N6/8/3Q4/R3K3 w - - 0 1";
+
+    chess::Position pos;
+    ASSERT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess);
+
+    History history = {};
+
+    const std::uint32_t killer =
+        FindMove<chess::Player::kWhite>(pos, "e1f1 ");
+    const std::uint32_t quiet =
+        FindMove<chess::Player::kWhite>(pos, "d2d4 ");
+
+    history[chess::util::ExtractFrom(quiet)][chess::util::ExtractTo(quiet)] =
+        100;
+
+    chess::MovePicker<chess::Player::kWhite> picker(
+        &pos, chess::kNullMove, {killer, chess::kNullMove}, history);
+
+    const std::vector<std::string> moves = Drain(&picker);
+
+    ASSERT_EQ(moves.size(), LegalMoves<chess::Player::kWhite>(pos).size());
+
+    EXPECT_EQ(moves[0], "b4c6 ");
+    EXPECT_EQ(moves[1], "e1f1 ");
+    EXPECT_EQ(moves[2], "d2d4 ");
+
+    // Losing captures come last, ordered by MVV/LVA
+
+    EXPECT_EQ(moves[moves.size()-3], "b4d5 ");
+    EXPECT_EQ(moves[moves.size()-2], "a1a7 ");
+    EXPECT_EQ(moves[moves.size()-1], "d2d5 ");
+}
+
+TEST(move_picker, lazy) {
+    const std::string fen = "1k6/pp6/2n1p3/3p4/1N6/8/3Q4/R3K3 w - - 0 1";
+
+    chess::Position pos;
+    ASSERT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess);
+
+    const History history = {};
+
+    const std::uint32_t hash_move =
+        FindMove<chess::Player::kWhite>(pos, "a1a7 ");
+
+    chess::MovePicker<chess::Player::kWhite> picker(
+        &pos, hash_move, {chess::kNullMove, chess::kNullMove}, history);
+
+    // A cutoff on the hash move or a winning capture means quiet moves are
+    // never generated
+
+    EXPECT_EQ(picker.Next(), hash_move);
+    EXPECT_EQ(picker.GetStage(),
+              chess::MovePicker<chess::Player::kWhite>::Stage::
+                  kGenerateCaptures);
+
+    EXPECT_EQ(chess::util::ToLongAlgebraic(picker.Next()), "b4c6 ");
+    EXPECT_EQ(picker.GetStage(),
+              chess::MovePicker<chess::Player::kWhite>::Stage::kGoodCaptures);
+
+    // Killers are validated without generating the other quiet moves
+
+    const std::uint32_t killer =
+        FindMove<chess::Player::kWhite>(pos, "e1f1 ");
+
+    chess::MovePicker<chess::Player::kWhite> killers(
+        &pos, chess::kNullMove, {killer, chess::kNullMove}, history);
+
+    EXPECT_EQ(killers.Next(), FindMove<chess::Player::kWhite>(pos, "b4c6 "));
+    EXPECT_EQ(killers.Next(), killer);
+    EXPECT_EQ(killers.GetStage(),
+              chess::MovePicker<chess::Player::kWhite>::Stage::kKillers);
+
+    // The hash move is not returned twice
+
+    const std::vector<std::string> rest = Drain(&picker);
+
+    EXPECT_EQ(std::count(rest.begin(), rest.end(), "a1a7 "), 0);
+    EXPECT_EQ(rest.size() + 2,
+              LegalMoves<chess::Player::kWhite>(pos).size());
+}
+
+TEST(move_picker, quiescence) {
+    const std::string fen = "1k6/pp6/2n1p3/3p4/1N6/8/3Q4/R3K3 w - - 0 1";
+
+    chess::Position pos;
+    ASSERT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess);
+
+    const History history = {};
+
+    chess::MovePicker<chess::Player::kWhite> picker(&pos, history, false);
+
+    EXPECT_EQ(Drain(&picker), std::vector<std::string>({"b4c6 "}));
+
+    // Quiet checks follow the winning captures
+
+    chess::MovePicker<chess::Player::kWhite> checks(&pos, history, true);
+
+    std::vector<std::string> moves = Drain(&checks);
+
+    ASSERT_FALSE(moves.empty());
+    EXPECT_EQ(moves[0], "b4c6 ");
+
+    std::sort(moves.begin() + 1, moves.end());
+
+    EXPECT_EQ(moves, std::vector<std::string>(
+        {"b4c6 ", "b4a6 ", "d2f4 ", "d2h2 "}));
+
+    // All evasions are returned in check
+
+    ASSERT_EQ(pos.Reset("4k3/8/8/8/4r3/8/3P4/4K3 w - - 0 1"),
+              chess::Position::FenError::kSuccess);
+
+    chess::MovePicker<chess::Player::kWhite> evasions(&pos, history, true);
+
+    moves = Drain(&evasions);
+    std::sort(moves.begin(), moves.end());
+
+    EXPECT_EQ(moves, LegalMoves<chess::Player::kWhite>(pos));
+}
+
+}  // namespace
@@ -8,7 +8,9 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <random>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -36,6 +38,115 @@ std::string PrintMoves(const std::uint32_t* moves, std::size_t size) {
     return out;
 }
 
+/**
+ * @brief Compare CountLegalMoves() and HasAnyLegalMove() against the
+ *        generated move list at every node of a tree
+ *
+ * @param pos   The root position, which is restored on return
+ * @param depth The depth of the tree, in plies
+ * @param ply   The ply of \a pos
+ *
+ * @return The number of nodes at which the counts disagree
+ */
+template <chess::Player P>
+std::size_t CompareCounts(chess::Position* pos, std::uint32_t depth,
+                          std::uint32_t ply = 0) {
+    std::uint32_t moves[chess::kMaxMoves];
+
+    const std::size_t n_moves = pos->InCheck<P>() ?
+        chess::GenerateCheckEvasions<P>(*pos, moves) :
+        chess::GenerateLegalMoves<P>(*pos, moves);
+
+    std::size_t errors = 0;
+
+    if (chess::CountLegalMoves<P>(*pos) != n_moves ||
+        chess::HasAnyLegalMove<P>(*pos) != (n_moves > 0)) {
+        ADD_FAILURE() << pos->GetFen() << " has " << n_moves << " moves";
+        errors++;
+    }
+
+    if (ply + 1 >= depth) return errors;
+
+    for (std::size_t i = 0; i < n_moves; i++) {
+        chess::Position::UndoInfo undo;
+        pos->MakeMove<P>(moves[i], &undo);
+        errors += CompareCounts<chess::util::opponent<P>()>(pos, depth,
+                                                            ply + 1);
+        pos->UnMakeMove<P>(moves[i], undo);
+    }
+
+    return errors;
+}
+
+/**
+ * @brief Compare GenerateChecks() against the quiet moves found to give
+ *        check by making them, at every node of a tree
+ *
+ * @param pos   The root position, which is restored on return
+ * @param depth The depth of the tree, in plies
+ * @param ply   The ply of \a pos
+ *
+ * @return The number of nodes at which the moves disagree
+ */
+template <chess::Player P>
+std::size_t CompareChecks(chess::Position* pos, std::uint32_t depth,
+                          std::uint32_t ply = 0) {
+    constexpr chess::Player O = chess::util::opponent<P>();
+
+    std::uint32_t moves[chess::kMaxMoves];
+
+    const bool in_check = pos->InCheck<P>();
+
+    const std::size_t n_moves = in_check ?
+        chess::GenerateCheckEvasions<P>(*pos, moves) :
+        chess::GenerateLegalMoves<P>(*pos, moves);
+
+    std::size_t errors = 0;
+
+    if (!in_check) {
+        std::vector<std::uint32_t> expected;
+
+        for (std::size_t i = 0; i < n_moves; i++) {
+            if (chess::util::ExtractCaptured(moves[i]) != chess::Piece::EMPTY ||
+                chess::util::ExtractPromoted(moves[i]) != chess::Piece::EMPTY) {
+                continue;
+            }
+
+            chess::Position::UndoInfo undo;
+            pos->MakeMove<P>(moves[i], &undo);
+            if (pos->InCheck<O>()) expected.push_back(moves[i]);
+            pos->UnMakeMove<P>(moves[i], undo);
+        }
+
+        std::uint32_t checks[chess::kMaxMoves];
+        const std::size_t n_checks =
+            chess::GenerateChecks<P>(*pos, pos->PinnedPieces<P>(), checks);
+
+        std::vector<std::uint32_t> actual(checks, checks + n_checks);
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+
+        if (actual != expected) {
+            ADD_FAILURE() << pos->GetFen() << "\nexpected:\n"
+                << PrintMoves(expected.data(), expected.size())
+                << "actual:\n" << PrintMoves(actual.data(), actual.size());
+            errors++;
+        }
+    }
+
+    if (ply + 1 >= depth) return errors;
+
+    for (std::size_t i = 0; i < n_moves; i++) {
+        chess::Position::UndoInfo undo;
+        pos->MakeMove<P>(moves[i], &undo);
+        errors += CompareChecks<O>(pos, depth, ply + 1);
+        pos->UnMakeMove<P>(moves[i], undo);
+    }
+
+    return errors;
+}
+
 TEST(MoveGen, GeneratePawnAdvances) {
     auto pos = chess::Position();
     EXPECT_EQ(pos.Reset("4r2b/4P3/5P2/1q1PKP1r/3P4/4P3/1q1Pr3/5k2 w - - 0 1"),
@@ -942,4 +1053,224 @@ TEST(MoveGen, GenerateCheckEvasions) {
     }
 }
 
+TEST(MoveGen, CountLegalMoves) {
+    auto pos = chess::Position();
+
+    // A pawn pinned along a diagonal cannot block a check by advancing two
+    // squares
+
+    ASSERT_EQ(pos.Reset("4k3/8/8/8/r6K/8/5P2/4b3 w - - 0 1"),
+              chess::Position::FenError::kSuccess);
+
+    std::uint32_t moves[chess::kMaxMoves];
+    EXPECT_EQ(chess::GenerateCheckEvasions<chess::Player::kWhite>(
+                  pos, moves), 4u);
+    EXPECT_EQ(chess::CountLegalMoves<chess::Player::kWhite>(pos), 4u);
+
+    // Checkmate and stalemate
+
+    ASSERT_EQ(pos.Reset("R5k1/5ppp/8/8/8/8/8/6K1 b - - 0 1"),
+              chess::Position::FenError::kSuccess);
+    EXPECT_EQ(chess::CountLegalMoves<chess::Player::kBlack>(pos), 0u);
+    EXPECT_FALSE(chess::HasAnyLegalMove<chess::Player::kBlack>(pos));
+
+    ASSERT_EQ(pos.Reset("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1"),
+              chess::Position::FenError::kSuccess);
+    EXPECT_EQ(chess::CountLegalMoves<chess::Player::kBlack>(pos), 0u);
+    EXPECT_FALSE(chess::HasAnyLegalMove<chess::Player::kBlack>(pos));
+
+    // Every node of a few small trees rich in pins, checks, promotions and
+    // en passant captures
+
+    const std::vector<std::pair<std::string, std::uint32_t>> trees = {
+        {chess::Position::kDefaultFen, 3},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -"
+         " 0 1", 3},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4},
+        {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+         3},
+        {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3}
+    };
+
+    for (const auto& [fen, depth] : trees) {
+        ASSERT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess);
+
+        const std::size_t errors = pos.ToMove() == chess::Player::kWhite ?
+            CompareCounts<chess::Player::kWhite>(&pos, depth) :
+            CompareCounts<chess::Player::kBlack>(&pos, depth);
+
+        EXPECT_EQ(errors, 0u) << fen;
+    }
+}
+
+TEST(MoveGen, GenerateChecks) {
+    auto pos = chess::Position();
+
+    // Direct checks by the rooks, including castling, and discovered checks
+    // by every move of the knight
+
+    ASSERT_EQ(pos.Reset("5k2/8/3N4/8/1B6/8/3R4/4K2R w K - 0 1"),
+              chess::Position::FenError::kSuccess);
+
+    std::uint32_t moves[chess::kMaxMoves];
+
+    std::size_t n_moves = chess::GenerateChecks<chess::Player::kWhite>(
+        pos, pos.PinnedPieces<chess::Player::kWhite>(), moves);
+
+    std::vector<std::string> actual;
+    for (std::size_t i = 0; i < n_moves; i++) {
+        actual.push_back(chess::util::ToLongAlgebraic(moves[i]));
+    }
+
+    std::sort(actual.begin(), actual.end());
+
+    const std::vector<std::string> expected = {
+        "d2f2 ", "d6b5 ", "d6b7 ", "d6c4 ", "d6c8 ", "d6e4 ", "d6e8 ",
+        "d6f5 ", "d6f7 ", "e1g1 ", "h1f1 ", "h1h8 "
+    };
+
+    EXPECT_EQ(actual, expected);
+
+    // Every node of a few small trees
+
+    const std::vector<std::pair<std::string, std::uint32_t>> trees = {
+        {chess::Position::kDefaultFen, 3},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -"
+         " 0 1", 3},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4},
+        {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+         3},
+        {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3},
+        {"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - -"
+         " 0 10", 3}
+    };
+
+    for (const auto& [fen, depth] : trees) {
+        ASSERT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess);
+
+        const std::size_t errors = pos.ToMove() == chess::Player::kWhite ?
+            CompareChecks<chess::Player::kWhite>(&pos, depth) :
+            CompareChecks<chess::Player::kBlack>(&pos, depth);
+
+        EXPECT_EQ(errors, 0u) << fen;
+    }
+}
+
+/**
+ * @brief Compare ValidateMove() against the generated move list for a set of
+ *        candidate moves
+ *
+ * @param pos        The position to validate moves in
+ * @param candidates The moves to try, legal or not
+ *
+ * @return The number of candidates on which the two disagree
+ */
+template <chess::Player P>
+std::size_t CompareValidation(const chess::Position& pos,
+                              const std::vector<std::uint32_t>& candidates) {
+    std::uint32_t moves[chess::kMaxMoves];
+
+    const std::size_t n_moves = pos.InCheck<P>() ?
+        chess::GenerateCheckEvasions<P>(pos, moves) :
+        chess::GenerateLegalMoves<P>(pos, moves);
+
+    std::sort(moves, moves + n_moves);
+
+    std::size_t errors = 0;
+
+    for (std::uint32_t move : candidates) {
+        const bool legal = std::binary_search(moves, moves + n_moves, move);
+
+        if (chess::ValidateMove<P>(pos, move) != legal && errors++ < 5) {
+            ADD_FAILURE() << pos.GetFen() << "\n"
+                << chess::debug::PrintMove(move) << " legal = " << legal;
+        }
+    }
+
+    return errors;
+}
+
+TEST(MoveGen, ValidateMove) {
+    // Random games from a few starting points. At each position, validate
+    // the legal moves, moves seen in other positions, altered copies of the
+    // legal moves and random bit patterns
+
+    const std::vector<std::string> fens = {
+        chess::Position::kDefaultFen,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"
+    };
+
+    std::mt19937 rng(2026);
+
+    std::vector<std::uint32_t> seen;
+    std::size_t errors = 0;
+
+    for (int game = 0; game < 40; game++) {
+        chess::Position pos;
+        ASSERT_EQ(pos.Reset(fens[game % fens.size()]),
+                  chess::Position::FenError::kSuccess);
+
+        for (std::uint32_t ply = 0; ply < 100; ply++) {
+            std::uint32_t moves[chess::kMaxMoves];
+            std::size_t n_moves;
+
+            const bool white = pos.ToMove() == chess::Player::kWhite;
+
+            if (white) {
+                n_moves = pos.InCheck<chess::Player::kWhite>() ?
+                    chess::GenerateCheckEvasions<chess::Player::kWhite>(
+                        pos, moves) :
+                    chess::GenerateLegalMoves<chess::Player::kWhite>(
+                        pos, moves);
+            } else {
+                n_moves = pos.InCheck<chess::Player::kBlack>() ?
+                    chess::GenerateCheckEvasions<chess::Player::kBlack>(
+                        pos, moves) :
+                    chess::GenerateLegalMoves<chess::Player::kBlack>(
+                        pos, moves);
+            }
+
+            std::vector<std::uint32_t> candidates(moves, moves + n_moves);
+
+            for (std::size_t i = 0; i < n_moves; i++) {
+                candidates.push_back(moves[i] ^ (1u << (12 + rng() % 9)));
+                candidates.push_back(moves[i] ^ (1u << (rng() % 12)));
+            }
+
+            for (int i = 0; i < 64; i++) {
+                candidates.push_back(rng() & ((1u << 21) - 1));
+            }
+
+            candidates.insert(candidates.end(), seen.begin(), seen.end());
+
+            errors += white ?
+                CompareValidation<chess::Player::kWhite>(pos, candidates) :
+                CompareValidation<chess::Player::kBlack>(pos, candidates);
+
+            if (n_moves == 0u) break;
+
+            const std::uint32_t move = moves[rng() % n_moves];
+
+            if (seen.size() < 512) {
+                seen.push_back(move);
+            } else {
+                seen[rng() % seen.size()] = move;
+            }
+
+            chess::Position::UndoInfo undo;
+
+            if (white) {
+                pos.MakeMove<chess::Player::kWhite>(move, &undo);
+            } else {
+                pos.MakeMove<chess::Player::kBlack>(move, &undo);
+            }
+        }
+    }
+
+    EXPECT_EQ(errors, 0u);
+}
+
 }  // namespace
@@ -16,8 +16,10 @@
 
 #include "gtest/gtest.h"
 
+#include "chess/game_history.h"
 #include "chess/logger.h"
 #include "chess/memory_pool.h"
+#include "chess/movegen.h"
 #include "chess/mtcs.h"
 #include "chess/null_stream_channel.h"
 #include "chess/position.h"
@@ -44,6 +46,81 @@ TEST(mtcs, random) {
     }
 }
 
+TEST(mtcs, random_uniform) {
+    constexpr std::size_t n_buckets = 7;
+    constexpr std::size_t n_samples = 70000;
+
+    std::array<std::size_t, n_buckets> counts = {};
+
+    for (std::size_t i = 0; i < n_samples; i++) {
+        counts[chess::random(n_buckets)]++;
+    }
+
+    // Each bucket expects 10000 hits, with a standard deviation of ~93
+
+    for (std::size_t count : counts) {
+        EXPECT_GT(count, 9500u);
+        EXPECT_LT(count, 10500u);
+    }
+}
+
+TEST(mtcs, simulate) {
+    chess::Position pos;
+    pos.Reset();
+
+    const chess::Position start(pos);
+
+    chess::GameHistory history;
+
+    for (std::size_t i = 0; i < 100; i++) {
+        const std::int32_t result =
+            chess::Mtcs::Simulate<chess::Player::kWhite>(&pos, &history, 0);
+
+        ASSERT_GE(result, -1);
+        ASSERT_LE(result, +1);
+        ASSERT_TRUE(pos == start);
+        ASSERT_EQ(history.Size(), 0u);
+    }
+
+    // Black to move and checkmated, so there is nothing to play out
+
+    ASSERT_EQ(pos.Reset("R5k1/5ppp/8/8/8/8/8/6K1 b - - 0 1"),
+              chess::Position::FenError::kSuccess);
+
+    EXPECT_EQ(
+        chess::Mtcs::Simulate<chess::Player::kBlack>(&pos, &history, 0), -1);
+
+    // Neither side can win with bare kings, so the playout ends at once
+
+    ASSERT_EQ(pos.Reset("8/8/4k3/8/8/3K4/8/8 w - - 0 1"),
+              chess::Position::FenError::kSuccess);
+
+    EXPECT_EQ(
+        chess::Mtcs::Simulate<chess::Player::kWhite>(&pos, &history, 0), 0);
+    EXPECT_EQ(history.Size(), 0u);
+
+    // A playout cut off at the ply limit goes to whoever is ahead
+
+    ASSERT_EQ(pos.Reset("4k3/8/8/8/8/8/8/3QK3 w - - 0 1"),
+              chess::Position::FenError::kSuccess);
+
+    constexpr std::size_t kLimit = 200;
+
+    EXPECT_EQ(
+        chess::Mtcs::Simulate<chess::Player::kWhite>(&pos, &history, kLimit),
+        1);
+    EXPECT_EQ(
+        chess::Mtcs::Simulate<chess::Player::kBlack>(&pos, &history, kLimit),
+        -1);
+
+    ASSERT_EQ(pos.Reset("4k3/4p3/8/8/8/8/4P3/4K3 w - - 0 1"),
+              chess::Position::FenError::kSuccess);
+
+    EXPECT_EQ(
+        chess::Mtcs::Simulate<chess::Player::kWhite>(&pos, &history, kLimit),
+        0);
+}
+
 TEST(mtcs, select) {
     using node_t = chess::Mtcs::Node;
     node_t node;
@@ -64,11 +141,15 @@ TEST(mtcs, select) {
 
     std::uint32_t moves[chess::kMaxPly];
 
+    chess::GameHistory history;
+
     // On the first iteration, we do a playout
 
     const int playout = pos.ToMove() == chess::Player::kWhite ?
-        node.Select<chess::Player::kWhite>(&pos, &pool, 0, moves) :
-        node.Select<chess::Player::kBlack>(&pos, &pool, 0, moves);
+        node.Select<chess::Player::kWhite>(&pos, &history, &pool, 0,
+                                           moves) :
+        node.Select<chess::Player::kBlack>(&pos, &history, &pool, 0,
+                                           moves);
 
     ASSERT_GE(playout, -1);
     ASSERT_LE(playout, +1);
@@ -77,14 +158,28 @@ TEST(mtcs, select) {
     EXPECT_NE(node.Average(), chess::kInfinityF64);
     EXPECT_EQ(node.Visits(), 1u);
 
+    // The second visit expands every child in a single block. Until each
+    // child has been visited once, nothing more is allocated
+
+    std::array<std::uint32_t, chess::kMaxMoves> legal_moves;
+    const std::size_t n_moves =
+        chess::GenerateLegalMoves<chess::Player::kWhite>(pos,
+                                                         legal_moves.data());
+    ASSERT_GE(n_moves, 1u);
+
     std::size_t iteration = 1;
 
     auto do_iteration = [&] () -> bool {
         const int result = pos.ToMove() == chess::Player::kWhite ?
-            node.Select<chess::Player::kWhite>(&pos, &pool, 0, moves) :
-            node.Select<chess::Player::kBlack>(&pos, &pool, 0, moves);
+            node.Select<chess::Player::kWhite>(&pos, &history, &pool, 0,
+                                               moves) :
+            node.Select<chess::Player::kBlack>(&pos, &history, &pool, 0,
+                                               moves);
 
-        const bool InUse_passed = pool.InUse() == iteration * sizeof(node_t);
+        const std::size_t block_size = n_moves * sizeof(node_t);
+
+        const bool InUse_passed = iteration <= n_moves ?
+            pool.InUse() == block_size : pool.InUse() > block_size;
         const bool Average_passed = node.Average() != chess::kInfinityF64;
         const bool Visits_passed = node.Visits() == iteration+1;
 
@@ -109,15 +204,9 @@ TEST(mtcs, select) {
         return InUse_passed && Average_passed && Visits_passed;
     };
 
-    ASSERT_TRUE(do_iteration());
-
-    iteration++;
-
-    ASSERT_TRUE(do_iteration());
-
-    iteration++;
-
-    ASSERT_TRUE(do_iteration());
+    for (; iteration <= n_moves + 1; iteration++) {
+        ASSERT_TRUE(do_iteration());
+    }
 }
 
 TEST(mtcs, mate_in_one) {
@@ -140,11 +229,15 @@ TEST(mtcs, mate_in_one) {
 
     std::uint32_t moves[chess::kMaxPly];
 
+    chess::GameHistory history;
+
     // On the first iteration, we do a playout
 
     const int playout = pos.ToMove() == chess::Player::kWhite ?
-        node.Select<chess::Player::kWhite>(&pos, &pool, 0, moves) :
-        node.Select<chess::Player::kBlack>(&pos, &pool, 0, moves);
+        node.Select<chess::Player::kWhite>(&pos, &history, &pool, 0,
+                                           moves) :
+        node.Select<chess::Player::kBlack>(&pos, &history, &pool, 0,
+                                           moves);
 
     ASSERT_GE(playout, -1);
     ASSERT_LE(playout, +1);
@@ -157,8 +250,10 @@ TEST(mtcs, mate_in_one) {
 
     auto do_iteration = [&] () -> bool {
         const int result = pos.ToMove() == chess::Player::kWhite ?
-            node.Select<chess::Player::kWhite>(&pos, &pool, 0, moves) :
-            node.Select<chess::Player::kBlack>(&pos, &pool, 0, moves);
+            node.Select<chess::Player::kWhite>(&pos, &history, &pool, 0,
+                                               moves) :
+            node.Select<chess::Player::kBlack>(&pos, &history, &pool, 0,
+                                               moves);
 
         const bool InUse_passed = pool.InUse() == iteration * sizeof(node_t);
         const bool Average_passed = node.Average() != chess::kInfinityF64;
@@ -200,4 +295,151 @@ TEST(mtcs, mate_in_one) {
 TEST(mtcs, no_moves) {
 }
 
+TEST(mtcs, run_threads) {
+    using node_t = chess::Mtcs::Node;
+
+    const std::string fen("6nk/6pp/7N/8/8/8/8/7K w - - 0 1");
+
+    chess::Position pos;
+    ASSERT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess);
+
+    auto channel = std::make_shared<chess::NullOstreamChannel>();
+
+    auto logger = std::make_shared<chess::Logger>("mtcs",  channel);
+
+    for (std::size_t threads : { 1, 4 }) {
+        auto pool = std::make_shared<chess::MemoryPool<node_t>>(
+            sizeof(node_t) * 100000, logger);
+
+        chess::Mtcs mtcs(pool, logger);
+        mtcs.SetIterations(2000);
+        mtcs.SetThreads(threads);
+
+        const std::uint32_t move = mtcs.Run(pos);
+
+        EXPECT_EQ(chess::util::ToLongAlgebraic(move), "h6f7 ")
+            << "threads = " << threads;
+        EXPECT_EQ(mtcs.Iterations(), 2000u);
+    }
+}
+
+TEST(mtcs, tree_reuse) {
+    using node_t = chess::Mtcs::Node;
+
+    auto channel = std::make_shared<chess::NullOstreamChannel>();
+
+    auto logger = std::make_shared<chess::Logger>("mtcs",  channel);
+
+    auto pool = std::make_shared<chess::MemoryPool<node_t>>(
+        sizeof(node_t) * 100000, logger);
+
+    chess::Mtcs mtcs(pool, logger);
+    mtcs.SetIterations(2000);
+
+    chess::Position pos;
+    pos.Reset();
+
+    const std::uint32_t move = mtcs.Run(pos);
+    ASSERT_NE(move, chess::kNullMove);
+
+    EXPECT_EQ(mtcs.RootVisits(), 2000u);
+
+    const std::size_t in_use = pool->InUse();
+
+    // Searching the same position again keeps the whole tree
+
+    mtcs.SetIterations(0);
+    EXPECT_EQ(mtcs.Run(pos), move);
+    EXPECT_EQ(mtcs.RootVisits(), 2000u);
+    EXPECT_EQ(pool->InUse(), in_use);
+
+    // After the selected move, the subtree below it becomes the new root
+    // and its siblings are returned to the pool
+
+    chess::Position::UndoInfo undo;
+    pos.MakeMove<chess::Player::kWhite>(move, &undo);
+
+    ASSERT_NE(mtcs.Run(pos), chess::kNullMove);
+    EXPECT_GT(mtcs.RootVisits(), 0u);
+    EXPECT_LT(mtcs.RootVisits(), 2000u);
+    EXPECT_LT(pool->InUse(), in_use);
+    EXPECT_GT(pool->InUse(), 0u);
+
+    // Two moves ahead also reuses the tree, provided the reply was explored.
+    // The most visited move has all of its replies expanded
+
+    mtcs.SetIterations(2000);
+    const std::uint32_t reply = mtcs.Run(pos);
+
+    pos.MakeMove<chess::Player::kBlack>(reply, &undo);
+
+    std::array<std::uint32_t, chess::kMaxMoves> moves;
+    ASSERT_GT(chess::GenerateLegalMoves<chess::Player::kWhite>(pos,
+                                                               moves.data()),
+              0u);
+
+    pos.MakeMove<chess::Player::kWhite>(moves[0], &undo);
+
+    mtcs.SetIterations(0);
+    ASSERT_NE(mtcs.Run(pos), chess::kNullMove);
+    EXPECT_GT(mtcs.RootVisits(), 0u);
+
+    // An unrelated position starts a new tree
+
+    ASSERT_EQ(pos.Reset("6nk/6pp/7N/8/8/8/8/7K w - - 0 1"),
+              chess::Position::FenError::kSuccess);
+
+    mtcs.Run(pos);
+    EXPECT_EQ(mtcs.RootVisits(), 0u);
+
+    mtcs.Clear();
+    EXPECT_EQ(pool->InUse(), 0u);
+}
+
+TEST(mtcs, info) {
+    using node_t = chess::Mtcs::Node;
+
+    /**
+     * Records the UCI output of the search
+     */
+    class StringChannel final : public chess::OutputStreamChannel {
+    public:
+        void Flush() noexcept override {
+        }
+
+        void Write(const chess::ConstDataBuffer& buffer) noexcept override {
+            output.append(buffer.data(), buffer.size());
+        }
+
+        std::string output;
+    };
+
+    auto channel = std::make_shared<StringChannel>();
+    auto logger = std::make_shared<chess::Logger>(
+        "mtcs", std::make_shared<chess::NullOstreamChannel>());
+
+    auto pool = std::make_shared<chess::MemoryPool<node_t>>(
+        sizeof(node_t) * 100000, logger);
+
+    chess::Mtcs mtcs(pool, logger);
+    mtcs.SetInfoChannel(channel);
+    mtcs.SetIterations(2000);
+
+    chess::Position pos;
+    ASSERT_EQ(pos.Reset("6nk/6pp/7N/8/8/8/8/7K w - - 0 1"),
+              chess::Position::FenError::kSuccess);
+
+    ASSERT_EQ(chess::util::ToLongAlgebraic(mtcs.Run(pos)), "h6f7 ");
+
+    // A final report is always sent, whose principal variation starts with
+    // the selected move
+
+    const std::string& output = channel->output;
+
+    EXPECT_EQ(output.rfind("info depth ", 0), 0u) << output;
+    EXPECT_NE(output.find(" nodes 2000 "), std::string::npos) << output;
+    EXPECT_NE(output.find(" pv h6f7"), std::string::npos) << output;
+    EXPECT_NE(output.find(" score cp "), std::string::npos) << output;
+}
+
 }  // anonymous namespace
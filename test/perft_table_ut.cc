@@ -0,0 +1,136 @@
+/**
+ *  \file   perft_table_ut.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chess/perft_table.h"
+
+namespace {
+TEST(perft_table, size) {
+    chess::PerftTable table(1);
+    EXPECT_EQ(table.Size(), 1024u * 1024u);
+
+    table.Resize(3);
+    EXPECT_EQ(table.Size(), 2u * 1024u * 1024u);
+
+    table.Resize(0);
+    EXPECT_EQ(table.Size(), 64u);
+}
+
+TEST(perft_table, probe_and_store) {
+    chess::PerftTable table(1);
+    std::uint64_t nodes = 0;
+
+    const std::uint64_t key = 0x123456789abcdef0;
+
+    EXPECT_FALSE(table.Probe(key, 5, &nodes));
+
+    table.Store(key, 5, 4865609);
+
+    ASSERT_TRUE(table.Probe(key, 5, &nodes));
+    EXPECT_EQ(nodes, 4865609u);
+
+    // The same position at another depth is a different subtree
+
+    EXPECT_FALSE(table.Probe(key, 4, &nodes));
+
+    table.Store(key, 4, 197281);
+
+    ASSERT_TRUE(table.Probe(key, 4, &nodes));
+    EXPECT_EQ(nodes, 197281u);
+    ASSERT_TRUE(table.Probe(key, 5, &nodes));
+    EXPECT_EQ(nodes, 4865609u);
+
+    // A key mapping to the same bucket must not match
+
+    EXPECT_FALSE(table.Probe(key ^ (std::uint64_t(1) << 63), 5, &nodes));
+
+    // Subtrees too large to store are skipped
+
+    table.Store(key, 9, chess::PerftTable::kMaxNodes + 1);
+    EXPECT_FALSE(table.Probe(key, 9, &nodes));
+
+    table.Clear();
+    EXPECT_FALSE(table.Probe(key, 5, &nodes));
+}
+
+TEST(perft_table, replacement) {
+    chess::PerftTable table(0);  // A single bucket
+    std::uint64_t nodes = 0;
+
+    constexpr auto kSize = chess::PerftTable::kBucketSize;
+
+    for (std::size_t i = 0; i < kSize; i++) {
+        table.Store(i + 1, 2 + i, i);
+    }
+
+    // Storing an existing entry again does not evict anything
+
+    table.Store(kSize, 1 + kSize, 1000);
+
+    for (std::size_t i = 0; i < kSize; i++) {
+        EXPECT_TRUE(table.Probe(i + 1, 2 + i, &nodes));
+    }
+
+    EXPECT_EQ(nodes, 1000u);
+
+    // The shallowest subtree is replaced first
+
+    table.Store(100, 3, 0);
+
+    EXPECT_FALSE(table.Probe(1, 2, &nodes));
+    EXPECT_TRUE(table.Probe(100, 3, &nodes));
+
+    for (std::size_t i = 1; i < kSize; i++) {
+        EXPECT_TRUE(table.Probe(i + 1, 2 + i, &nodes));
+    }
+}
+
+TEST(perft_table, concurrent) {
+    chess::PerftTable table(1);
+
+    // Each thread stores counts which are a function of the key and depth,
+    // so any count returned by a probe can be verified
+
+    auto worker = [&table](unsigned seed, bool* ok) {
+        std::mt19937_64 gen(seed);
+        std::uint64_t nodes = 0;
+
+        for (int i = 0; i < 200000; i++) {
+            const std::uint64_t key = gen() % 100000;
+            const std::uint32_t depth = 2 + key % 5;
+
+            if (table.Probe(key, depth, &nodes) && nodes != key * depth) {
+                *ok = false;
+            }
+
+            table.Store(key, depth, key * depth);
+        }
+    };
+
+    constexpr int kThreads = 4;
+
+    bool ok[kThreads] = {};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < kThreads; i++) {
+        ok[i] = true;
+        threads.emplace_back(worker, i, &ok[i]);
+    }
+
+    for (auto& thread : threads) thread.join();
+
+    for (int i = 0; i < kThreads; i++) {
+        EXPECT_TRUE(ok[i]);
+    }
+}
+
+}  // namespace
@@ -9,6 +9,7 @@
 #include <cmath>
 #include <map>
 #include <ostream>
+#include <random>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -17,6 +18,7 @@
 #include "gtest/gtest.h"
 
 #include "chess/debug.h"
+#include "chess/movegen.h"
 #include "chess/position.h"
 
 namespace {
@@ -77,7 +79,11 @@ void CheckMove(chess::Position* pos, std::int32_t move) {
         return 0;
     };
 
-    pos->MakeMove<who>(move, 0);
+    chess::Position::UndoInfo undo;
+    pos->MakeMove<who>(move, &undo);
+
+    EXPECT_EQ(pos->Hash(), pos->ComputeHash());
+    EXPECT_NE(pos->Hash(), orig.Hash());
 
     EXPECT_EQ(pos->ToMove(), chess::util::opponent<who>());
     if (pos->ToMove() == chess::Player::kWhite) {
@@ -258,9 +264,10 @@ void CheckMove(chess::Position* pos, std::int32_t move) {
         EXPECT_EQ(pos->HalfMoveNumber(), 0);
     }
 
-    pos->UnMakeMove<who>(move, 0);
+    pos->UnMakeMove<who>(move, undo);
 
     EXPECT_EQ(*pos, orig);
+    EXPECT_EQ(pos->Hash(), orig.Hash());
 }
 
 TEST(Position, PieceSet_Get) {
@@ -1482,4 +1489,200 @@ TEST(Position, MakeUndoMove) {
                                     chess::Square::G1));
 }
 
+TEST(Position, Hash) {
+    auto pos1 = chess::Position();
+    auto pos2 = chess::Position();
+
+    ASSERT_EQ(pos1.Reset(), chess::Position::FenError::kSuccess);
+    EXPECT_EQ(pos1.Hash(), pos1.ComputeHash());
+
+    // Side to move, castling rights, and en passant targets are all part
+    // of the signature
+
+    ASSERT_EQ(pos2.Reset(
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR b KQkq - 0 1"),
+        chess::Position::FenError::kSuccess);
+    EXPECT_NE(pos1.Hash(), pos2.Hash());
+
+    ASSERT_EQ(pos2.Reset(
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w Kkq - 0 1"),
+        chess::Position::FenError::kSuccess);
+    EXPECT_NE(pos1.Hash(), pos2.Hash());
+
+    ASSERT_EQ(pos1.Reset("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1"),
+              chess::Position::FenError::kSuccess);
+    ASSERT_EQ(pos2.Reset("4k3/8/8/3pP3/8/8/8/4K3 w - - 0 1"),
+              chess::Position::FenError::kSuccess);
+    EXPECT_NE(pos1.Hash(), pos2.Hash());
+
+    // An en passant target that nobody can capture on is ignored
+
+    ASSERT_EQ(pos1.Reset("4k3/8/8/3p4/8/8/8/4K3 w - d6 0 1"),
+              chess::Position::FenError::kSuccess);
+    ASSERT_EQ(pos2.Reset("4k3/8/8/3p4/8/8/8/4K3 w - - 0 1"),
+              chess::Position::FenError::kSuccess);
+    EXPECT_EQ(pos1.Hash(), pos2.Hash());
+
+    // Transpositions hash the same
+
+    ASSERT_EQ(pos1.Reset(), chess::Position::FenError::kSuccess);
+    ASSERT_EQ(pos2.Reset(), chess::Position::FenError::kSuccess);
+
+    const std::uint64_t start = pos1.Hash();
+
+    const std::int32_t nf3 = chess::util::PackMove(
+        chess::Piece::EMPTY, chess::Square::G1, chess::Piece::KNIGHT,
+        chess::Piece::EMPTY, chess::Square::F3);
+    const std::int32_t ng1 = chess::util::PackMove(
+        chess::Piece::EMPTY, chess::Square::F3, chess::Piece::KNIGHT,
+        chess::Piece::EMPTY, chess::Square::G1);
+    const std::int32_t nf6 = chess::util::PackMove(
+        chess::Piece::EMPTY, chess::Square::G8, chess::Piece::KNIGHT,
+        chess::Piece::EMPTY, chess::Square::F6);
+    const std::int32_t ng8 = chess::util::PackMove(
+        chess::Piece::EMPTY, chess::Square::F6, chess::Piece::KNIGHT,
+        chess::Piece::EMPTY, chess::Square::G8);
+    const std::int32_t nc3 = chess::util::PackMove(
+        chess::Piece::EMPTY, chess::Square::B1, chess::Piece::KNIGHT,
+        chess::Piece::EMPTY, chess::Square::C3);
+    const std::int32_t nc6 = chess::util::PackMove(
+        chess::Piece::EMPTY, chess::Square::B8, chess::Piece::KNIGHT,
+        chess::Piece::EMPTY, chess::Square::C6);
+
+    std::array<chess::Position::UndoInfo, 7> undo;
+
+    pos1.MakeMove<chess::Player::kWhite>(nf3, &undo[0]);
+    pos1.MakeMove<chess::Player::kBlack>(nf6, &undo[1]);
+    pos1.MakeMove<chess::Player::kWhite>(ng1, &undo[2]);
+    pos1.MakeMove<chess::Player::kBlack>(ng8, &undo[3]);
+
+    EXPECT_EQ(pos1.Hash(), start);
+
+    pos1.MakeMove<chess::Player::kWhite>(nf3, &undo[4]);
+    pos1.MakeMove<chess::Player::kBlack>(nc6, &undo[5]);
+    pos1.MakeMove<chess::Player::kWhite>(nc3, &undo[6]);
+
+    pos2.MakeMove<chess::Player::kWhite>(nc3, &undo[0]);
+    pos2.MakeMove<chess::Player::kBlack>(nc6, &undo[1]);
+    pos2.MakeMove<chess::Player::kWhite>(nf3, &undo[2]);
+
+    EXPECT_EQ(pos1.Hash(), pos2.Hash());
+    EXPECT_NE(pos1.Hash(), start);
+
+    pos1.UnMakeMove<chess::Player::kWhite>(nc3, undo[6]);
+    pos1.UnMakeMove<chess::Player::kBlack>(nc6, undo[5]);
+    pos1.UnMakeMove<chess::Player::kWhite>(nf3, undo[4]);
+
+    EXPECT_EQ(pos1.Hash(), start);
+}
+
+/**
+ * Play random legal moves and compare the incremental hash signature
+ * against a full recompute at every ply
+ */
+template <chess::Player P>
+void RandomWalk(chess::Position* pos, std::mt19937* gen, std::uint32_t ply,
+                std::uint32_t max_ply) {
+    if (ply >= max_ply) return;
+
+    std::array<std::uint32_t, chess::kMaxMoves> moves;
+
+    const std::size_t n_moves = pos->InCheck<P>() ?
+        chess::GenerateCheckEvasions<P>(*pos, moves.data()) :
+        chess::GenerateLegalMoves<P>(*pos, moves.data());
+
+    if (n_moves == 0u) return;
+
+    const std::uint64_t hash = pos->Hash();
+
+    const std::uint32_t move = moves[(*gen)() % n_moves];
+
+    chess::Position::UndoInfo undo;
+    pos->MakeMove<P>(move, &undo);
+
+    ASSERT_EQ(pos->Hash(), pos->ComputeHash())
+        << pos->GetFen() << "\n" << chess::debug::PrintMove(move);
+
+    RandomWalk<chess::util::opponent<P>()>(pos, gen, ply+1, max_ply);
+
+    pos->UnMakeMove<P>(move, undo);
+
+    ASSERT_EQ(pos->Hash(), hash);
+}
+
+TEST(Position, HashIncremental) {
+    const std::vector<std::string> fens = {
+        chess::Position::kDefaultFen,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1"
+    };
+
+    std::mt19937 gen(12345);
+
+    for (const auto& fen : fens) {
+        auto pos = chess::Position();
+        ASSERT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess);
+
+        for (int i = 0; i < 200; i++) {
+            pos.ToMove() == chess::Player::kWhite ?
+                RandomWalk<chess::Player::kWhite>(&pos, &gen, 0, 60) :
+                RandomWalk<chess::Player::kBlack>(&pos, &gen, 0, 60);
+        }
+    }
+}
+
+/**
+ * Check that copy-make and make/unmake reach the same positions, and that
+ * copy-make leaves the parent untouched
+ */
+template <chess::Player P>
+void CompareCopyMake(chess::Position* pos, std::uint32_t depth) {
+    if (depth == 0u) return;
+
+    std::array<std::uint32_t, chess::kMaxMoves> moves;
+
+    const std::size_t n_moves = pos->InCheck<P>() ?
+        chess::GenerateCheckEvasions<P>(*pos, moves.data()) :
+        chess::GenerateLegalMoves<P>(*pos, moves.data());
+
+    const chess::Position orig(*pos);
+
+    for (std::size_t i = 0; i < n_moves; i++) {
+        chess::Position child;
+        child.CopyMake<P>(*pos, moves[i]);
+
+        EXPECT_EQ(*pos, orig);
+
+        chess::Position::UndoInfo undo;
+        pos->MakeMove<P>(moves[i], &undo);
+
+        ASSERT_EQ(child, *pos) << chess::debug::PrintMove(moves[i]);
+        ASSERT_EQ(child.Hash(), pos->Hash());
+        ASSERT_EQ(child.HalfMoveNumber(), pos->HalfMoveNumber());
+
+        CompareCopyMake<chess::util::opponent<P>()>(pos, depth-1);
+
+        pos->UnMakeMove<P>(moves[i], undo);
+    }
+}
+
+TEST(Position, CopyMake) {
+    const std::vector<std::string> fens = {
+        chess::Position::kDefaultFen,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1"
+    };
+
+    for (const auto& fen : fens) {
+        auto pos = chess::Position();
+        ASSERT_EQ(pos.Reset(fen), chess::Position::FenError::kSuccess);
+
+        pos.ToMove() == chess::Player::kWhite ?
+            CompareCopyMake<chess::Player::kWhite>(&pos, 3) :
+            CompareCopyMake<chess::Player::kBlack>(&pos, 3);
+    }
+}
+
 }  // namespace
@@ -364,4 +364,39 @@ TEST(static_exchange, next_piece_king) {
     ASSERT_EQ(black_pieces.Next(), chess::Piece::EMPTY);
 }
 
+TEST(static_exchange, compute_see) {
+    struct TestCase {
+        const char* fen;
+        chess::Square square;
+        std::int16_t expected;
+    };
+
+    const std::vector<TestCase> cases = {
+        // Undefended pawn
+        { "4k3/8/8/3p4/4P3/8/8/4K3 w - - 0 1", chess::Square::D5, 100 },
+        // Pawn defended by a pawn; capturing with a pawn is still even
+        { "4k3/8/2p5/3p4/4P3/8/8/4K3 w - - 0 1", chess::Square::D5, 0 },
+        // Knight defended by a pawn, attacked by a rook only
+        { "4k3/8/2p5/3n4/8/8/8/3RK3 w - - 0 1", chess::Square::D5, 0 },
+        // Knight defended by a pawn, attacked by a pawn
+        { "4k3/8/2p5/3n4/4P3/8/8/4K3 w - - 0 1", chess::Square::D5, 225 },
+        // Rook against a rook defended once
+        { "3rk3/8/8/3r4/8/8/8/3RK3 w - - 0 1", chess::Square::D5, 0 },
+        // Doubled rooks against a rook defended once (x-ray)
+        { "3rk3/8/8/3r4/8/8/3R4/3RK3 w - - 0 1", chess::Square::D5, 500 },
+        // Queen against a pawn defended by a bishop behind another pawn
+        { "4k3/1b6/2p5/3p4/8/8/8/3QK3 w - - 0 1", chess::Square::D5, 0 },
+        // Nothing attacks the square
+        { "4k3/8/8/3p4/8/8/8/4K3 w - - 0 1", chess::Square::D5, 0 }
+    };
+
+    for (const auto& test : cases) {
+        chess::Position pos;
+        ASSERT_EQ(pos.Reset(test.fen), chess::Position::FenError::kSuccess);
+
+        EXPECT_EQ(chess::ComputeSee<chess::Player::kWhite>(pos, test.square),
+                  test.expected) << test.fen;
+    }
+}
+
 }  // namespace
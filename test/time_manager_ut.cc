@@ -0,0 +1,125 @@
+/**
+ *  \file   time_manager_ut.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "chess/time_manager.h"
+
+namespace {
+TEST(time_manager, untimed) {
+    chess::TimeManager manager;
+
+    EXPECT_FALSE(manager.SoftLimitReached());
+    EXPECT_FALSE(manager.HardLimitReached());
+
+    chess::SearchLimits limits;
+    limits.infinite = true;
+    limits.wtime = 1000;
+
+    manager.Start(limits, chess::Player::kWhite);
+
+    EXPECT_FALSE(manager.SoftLimit().has_value());
+    EXPECT_FALSE(manager.HardLimit().has_value());
+    EXPECT_FALSE(manager.HardLimitReached());
+}
+
+TEST(time_manager, movetime) {
+    chess::TimeManager manager;
+
+    chess::SearchLimits limits;
+    limits.movetime = 1000;
+
+    manager.Start(limits, chess::Player::kBlack);
+
+    const std::int64_t expected = 1000 - chess::TimeManager::kMoveOverhead;
+
+    EXPECT_EQ(manager.SoftLimit(), expected);
+    EXPECT_EQ(manager.HardLimit(), expected);
+
+    // The budget never drops to zero
+
+    limits.movetime = 1;
+    manager.Start(limits, chess::Player::kBlack);
+
+    EXPECT_EQ(manager.HardLimit(), 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    EXPECT_TRUE(manager.SoftLimitReached());
+    EXPECT_TRUE(manager.HardLimitReached());
+    EXPECT_GE(manager.Elapsed(), 5);
+}
+
+TEST(time_manager, clock) {
+    chess::TimeManager manager;
+
+    chess::SearchLimits limits;
+    limits.wtime = 60030;
+    limits.btime = 1030;
+    limits.winc  = 1000;
+
+    // Sudden death: the remaining time is shared among a default number of
+    // moves, plus most of the increment
+
+    manager.Start(limits, chess::Player::kWhite);
+
+    const std::int64_t soft =
+        60000 / chess::TimeManager::kDefaultMovesToGo + 750;
+
+    EXPECT_EQ(manager.SoftLimit(), soft);
+    EXPECT_EQ(manager.HardLimit(),
+              soft * chess::TimeManager::kHardLimitFactor);
+    EXPECT_FALSE(manager.SoftLimitReached());
+
+    // Each player's own clock is used
+
+    manager.Start(limits, chess::Player::kBlack);
+
+    EXPECT_EQ(manager.SoftLimit(),
+              1000 / chess::TimeManager::kDefaultMovesToGo);
+
+    // With one move to go, all of the remaining time may be used but no more
+
+    limits.movestogo = 1;
+    manager.Start(limits, chess::Player::kWhite);
+
+    EXPECT_EQ(manager.SoftLimit(), 60000);
+    EXPECT_EQ(manager.HardLimit(), 60000);
+
+    // Out of time
+
+    limits.btime = 0;
+    manager.Start(limits, chess::Player::kBlack);
+
+    EXPECT_EQ(manager.SoftLimit(), 1);
+    EXPECT_EQ(manager.HardLimit(), 1);
+}
+
+TEST(time_manager, ponder) {
+    chess::TimeManager manager;
+
+    chess::SearchLimits limits;
+    limits.ponder = true;
+    limits.movetime = 31;
+
+    // The clock does not run while pondering
+
+    manager.Start(limits, chess::Player::kWhite);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_FALSE(manager.HardLimitReached());
+
+    manager.PonderHit();
+    EXPECT_FALSE(manager.HardLimitReached());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_TRUE(manager.HardLimitReached());
+}
+
+}  // namespace
@@ -0,0 +1,171 @@
+/**
+ *  \file   transposition_table_ut.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chess/transposition_table.h"
+
+namespace {
+TEST(TranspositionTable, Size) {
+    chess::TranspositionTable table(1);
+    EXPECT_EQ(table.Size(), 1024u * 1024u);
+
+    table.Resize(3);
+    EXPECT_EQ(table.Size(), 2u * 1024u * 1024u);
+
+    table.Resize(0);
+    EXPECT_EQ(table.Size(), 64u);
+}
+
+TEST(TranspositionTable, ProbeAndStore) {
+    chess::TranspositionTable table(1);
+    chess::TranspositionTable::Entry entry;
+
+    const std::uint64_t key = 0x123456789abcdef0;
+
+    EXPECT_FALSE(table.Probe(key, &entry));
+
+    table.Store(key, 0x1abcde, -1234, 7, chess::Bound::kLower);
+
+    ASSERT_TRUE(table.Probe(key, &entry));
+    EXPECT_EQ(entry.move, 0x1abcdeu);
+    EXPECT_EQ(entry.score, -1234);
+    EXPECT_EQ(entry.depth, 7);
+    EXPECT_EQ(entry.bound, chess::Bound::kLower);
+
+    // A key mapping to the same bucket must not match
+
+    EXPECT_FALSE(table.Probe(key ^ (std::uint64_t(1) << 63), &entry));
+
+    // A shallower, inexact result does not overwrite a deeper one
+
+    table.Store(key, 0x1234, 50, 3, chess::Bound::kUpper);
+
+    ASSERT_TRUE(table.Probe(key, &entry));
+    EXPECT_EQ(entry.depth, 7);
+    EXPECT_EQ(entry.score, -1234);
+
+    // An exact result does, and keeps the stored move if none is given
+
+    table.Store(key, 0, 50, 3, chess::Bound::kExact);
+
+    ASSERT_TRUE(table.Probe(key, &entry));
+    EXPECT_EQ(entry.move, 0x1abcdeu);
+    EXPECT_EQ(entry.score, 50);
+    EXPECT_EQ(entry.depth, 3);
+    EXPECT_EQ(entry.bound, chess::Bound::kExact);
+
+    table.Clear();
+    EXPECT_FALSE(table.Probe(key, &entry));
+}
+
+TEST(TranspositionTable, Replacement) {
+    chess::TranspositionTable table(0);  // A single bucket
+    chess::TranspositionTable::Entry entry;
+
+    constexpr auto kSize = chess::TranspositionTable::kBucketSize;
+
+    for (std::size_t i = 0; i < kSize; i++) {
+        table.Store(i + 1, 0, 0, 10 + i, chess::Bound::kExact);
+    }
+
+    // The shallowest entry is replaced first
+
+    table.Store(100, 0, 0, 20, chess::Bound::kExact);
+
+    EXPECT_FALSE(table.Probe(1, &entry));
+    for (std::size_t i = 1; i < kSize; i++) {
+        EXPECT_TRUE(table.Probe(i + 1, &entry));
+    }
+
+    // ...unless it is newer than the others
+
+    table.NewSearch();
+    table.Store(200, 0, 0, 6, chess::Bound::kExact);
+    table.Store(300, 0, 0, 6, chess::Bound::kExact);
+
+    EXPECT_FALSE(table.Probe(2, &entry));
+    EXPECT_FALSE(table.Probe(3, &entry));
+    EXPECT_TRUE(table.Probe(100, &entry));
+    EXPECT_TRUE(table.Probe(200, &entry));
+    EXPECT_TRUE(table.Probe(300, &entry));
+}
+
+TEST(TranspositionTable, HashFull) {
+    chess::TranspositionTable table(1);
+    EXPECT_EQ(table.HashFull(), 0);
+
+    const std::size_t n_buckets =
+        table.Size() / (sizeof(std::uint64_t) * 2 *
+                        chess::TranspositionTable::kBucketSize);
+
+    // Fill every slot of the first half of the buckets
+
+    for (std::size_t i = 0; i < n_buckets / 2; i++) {
+        for (std::size_t j = 0; j < chess::TranspositionTable::kBucketSize;
+             j++) {
+            table.Store(i + j * n_buckets, 0, 0, 1, chess::Bound::kExact);
+        }
+    }
+
+    EXPECT_EQ(table.HashFull(), 1000);
+
+    // Entries from a previous search are not counted
+
+    table.NewSearch();
+    EXPECT_EQ(table.HashFull(), 0);
+}
+
+TEST(TranspositionTable, Concurrent) {
+    chess::TranspositionTable table(1);
+
+    // Each thread stores entries whose contents are a function of the key,
+    // so any entry returned by a probe can be verified
+
+    auto worker = [&table](unsigned seed, bool* ok) {
+        std::mt19937_64 gen(seed);
+        chess::TranspositionTable::Entry entry;
+
+        for (int i = 0; i < 200000; i++) {
+            const std::uint64_t key = gen() % 100000;
+
+            const auto move  = static_cast<std::uint32_t>(key & 0x1fffff);
+            const auto score = static_cast<int>(key % 30000);
+
+            if (table.Probe(key, &entry)) {
+                if (entry.move != move || entry.score != score ||
+                    entry.depth != 5) {
+                    *ok = false;
+                }
+            }
+
+            table.Store(key, move, score, 5, chess::Bound::kExact);
+        }
+    };
+
+    constexpr int kThreads = 4;
+
+    bool ok[kThreads] = {};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < kThreads; i++) {
+        ok[i] = true;
+        threads.emplace_back(worker, i, &ok[i]);
+    }
+
+    for (auto& thread : threads) thread.join();
+
+    for (int i = 0; i < kThreads; i++) {
+        EXPECT_TRUE(ok[i]);
+    }
+}
+
+}  // namespace
@@ -0,0 +1,123 @@
+/**
+ *  \file   uci_ut.cc
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "chess/data_buffer.h"
+#include "chess/engine_interface.h"
+#include "chess/logger.h"
+#include "chess/null_stream_channel.h"
+#include "chess/stream_channel.h"
+#include "chess/time_manager.h"
+#include "chess/uci.h"
+
+namespace {
+class MockEngine final : public chess::EngineInterface {
+public:
+    MOCK_METHOD(void, Uci, (), (noexcept, override));
+    MOCK_METHOD(void, DebugMode, (bool enable), (noexcept, override));
+    MOCK_METHOD(bool, IsReady, (), (const, noexcept, override));
+    MOCK_METHOD(bool, SetOption, (const std::string& name,
+                                  const std::vector<std::string>& args),
+                (noexcept, override));
+    MOCK_METHOD(void, UciNewGame, (), (noexcept, override));
+    MOCK_METHOD(bool, Position, (const std::vector<std::string>& args),
+                (noexcept, override));
+    MOCK_METHOD(void, Go, (const chess::SearchLimits& limits),
+                (noexcept, override));
+    MOCK_METHOD(void, Stop, (), (noexcept, override));
+    MOCK_METHOD(void, PonderHit, (), (noexcept, override));
+};
+
+/**
+ * An input channel whose commands are sent by the test
+ */
+class ScriptedChannel final : public chess::InputStreamChannel {
+public:
+    void Close() noexcept override {
+    }
+
+    void Poll() noexcept override {
+    }
+
+    bool IsClosed() const noexcept override {
+        return false;
+    }
+
+    void Send(const std::string& command) {
+        emit_(chess::ConstDataBuffer(command.data(), command.size()));
+    }
+};
+
+/**
+ * @brief Send a "go" command and capture the limits given to the engine
+ *
+ * @param command The full command
+ *
+ * @return The search limits
+ */
+chess::SearchLimits Go(const std::string& command) {
+    auto channel = std::make_shared<ScriptedChannel>();
+    auto engine  = std::make_shared<MockEngine>();
+    auto logger  = std::make_shared<chess::Logger>(
+        "uci", std::make_shared<chess::NullOstreamChannel>());
+
+    chess::UciProtocol protocol(channel, logger, engine);
+
+    chess::SearchLimits limits;
+
+    EXPECT_CALL(*engine, Go(::testing::_))
+        .Times(1)
+        .WillOnce(::testing::SaveArg<0>(&limits));
+
+    channel->Send(command);
+
+    return limits;
+}
+
+TEST(uci, go) {
+    const chess::SearchLimits limits =
+        Go("go wtime 1000 btime 2000 winc 10 binc 20 movestogo 5");
+
+    EXPECT_EQ(limits.wtime, 1000);
+    EXPECT_EQ(limits.btime, 2000);
+    EXPECT_EQ(limits.winc, 10);
+    EXPECT_EQ(limits.binc, 20);
+    EXPECT_EQ(limits.movestogo, 5);
+    EXPECT_FALSE(limits.infinite);
+}
+
+TEST(uci, go_unknown_parameter) {
+    const chess::SearchLimits limits = Go("go wtime 1000 foo");
+
+    EXPECT_EQ(limits.wtime, 1000);
+    EXPECT_FALSE(limits.btime);
+}
+
+TEST(uci, go_invalid_value) {
+    chess::SearchLimits limits = Go("go movetime x");
+    EXPECT_FALSE(limits.movetime);
+
+    limits = Go("go nodes 99999999999999999999999 depth 3");
+    EXPECT_FALSE(limits.nodes);
+    EXPECT_EQ(limits.depth, 3);
+
+    // A missing value leaves the next parameter intact
+
+    limits = Go("go movetime infinite");
+    EXPECT_FALSE(limits.movetime);
+    EXPECT_TRUE(limits.infinite);
+
+    limits = Go("go depth");
+    EXPECT_FALSE(limits.depth);
+}
+
+}  // namespace